@@ -0,0 +1,437 @@
+#include "unrealsdk/pch.h"
+
+#include "unrealsdk/benchmark.h"
+#include "unrealsdk/commands.h"
+#include "unrealsdk/config.h"
+#include "unrealsdk/hook_manager.h"
+#include "unrealsdk/memory.h"
+#include "unrealsdk/unreal/classes/uclass.h"
+#include "unrealsdk/unreal/classes/ufunction.h"
+#include "unrealsdk/unreal/classes/uobject.h"
+#include "unrealsdk/unreal/classes/uproperty.h"
+#include "unrealsdk/unreal/find_class.h"
+#include "unrealsdk/unreal/structs/fname.h"
+#include "unrealsdk/unreal/wrappers/gobjects.h"
+#include "unrealsdk/unreal/wrappers/wrapped_struct.h"
+#include "unrealsdk/unrealsdk.h"
+#include "unrealsdk/utils.h"
+#include "unrealsdk/version.h"
+
+using namespace unrealsdk::unreal;
+using namespace unrealsdk::memory;
+
+namespace unrealsdk::benchmark {
+
+#pragma region Implementation
+#ifndef UNREALSDK_IMPORTING
+namespace impl {
+
+namespace {
+
+// How many objects of each type to sample out of GObjects
+const constexpr size_t MAX_SAMPLES = 1000;
+// How many times to repeat each benchmark, after a single warmup run
+const constexpr size_t REPETITIONS = 5;
+// How many times to loop over the samples in each repetition
+const constexpr size_t SAMPLE_LOOPS = 100;
+// How many patterns to use when benchmarking batch sigscans
+const constexpr size_t BATCH_PATTERN_COUNT = 16;
+
+const constexpr std::wstring_view HOOK_IDENTIFIER = L"unrealsdk_benchmark";
+
+// Results are written here, so that the compiler can't optimize the benchmarks away
+volatile size_t sink = 0;
+
+struct Result {
+    std::string_view name;
+    size_t ops;
+    double mean_ns_per_op;
+    double best_ns_per_op;
+};
+
+/**
+ * @brief Times a benchmark.
+ *
+ * @tparam Func The type of the benchmark function.
+ * @param name The name of the benchmark.
+ * @param ops How many operations a single run of the function performs.
+ * @param func The benchmark function. Should return a value depending on all the work it did.
+ * @return The benchmark's results.
+ */
+template <typename Func>
+Result measure(std::string_view name, size_t ops, Func&& func) {
+    sink = sink + func();
+
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds best = std::chrono::nanoseconds::max();
+    for (size_t i = 0; i < REPETITIONS; i++) {
+        auto start = std::chrono::steady_clock::now();
+        sink = sink + func();
+        auto time = std::chrono::steady_clock::now() - start;
+
+        total += time;
+        best = std::min(best, time);
+    }
+
+    auto ops_double = static_cast<double>(std::max<size_t>(ops, 1));
+    Result result{
+        .name = name,
+        .ops = ops,
+        .mean_ns_per_op = static_cast<double>(total.count()) / REPETITIONS / ops_double,
+        .best_ns_per_op = static_cast<double>(best.count()) / ops_double,
+    };
+    LOG(INFO, "{:<36} {:>12.1f}ns/op (best {:.1f}ns/op, {} ops)", name, result.mean_ns_per_op,
+        result.best_ns_per_op, ops);
+    return result;
+}
+
+struct Samples {
+    std::vector<UFunction*> functions;
+    std::vector<UClass*> classes;
+    std::vector<FName> names;
+
+    // Each of these lists are derived from the above
+    std::vector<std::pair<UClass*, FName>> props;
+    std::vector<std::wstring> name_strs;
+    std::vector<WrappedStruct> params;
+};
+
+/**
+ * @brief Samples objects out of GObjects to benchmark against.
+ *
+ * @return The samples.
+ */
+Samples gather_samples(void) {
+    static const auto ufunction_cls = find_class<UFunction>();
+    static const auto uclass_cls = find_class<UClass>();
+
+    Samples samples{};
+    for (auto obj : gobjects()) {
+        if (obj == nullptr) {
+            continue;
+        }
+
+        if (samples.names.size() < MAX_SAMPLES) {
+            samples.names.push_back(obj->Name());
+        }
+        if (samples.functions.size() < MAX_SAMPLES && obj->is_instance(ufunction_cls)) {
+            samples.functions.push_back(reinterpret_cast<UFunction*>(obj));
+        } else if (samples.classes.size() < MAX_SAMPLES && obj->is_instance(uclass_cls)) {
+            samples.classes.push_back(reinterpret_cast<UClass*>(obj));
+        }
+
+        if (samples.names.size() >= MAX_SAMPLES && samples.functions.size() >= MAX_SAMPLES
+            && samples.classes.size() >= MAX_SAMPLES) {
+            break;
+        }
+    }
+
+    for (auto cls : samples.classes) {
+        for (auto prop : cls->properties()) {
+            samples.props.emplace_back(cls, prop->Name());
+        }
+    }
+    for (auto name : samples.names) {
+        samples.name_strs.emplace_back(name);
+    }
+    for (auto func : samples.functions) {
+        if (func->get_struct_size() > 0) {
+            samples.params.emplace_back(func);
+        }
+    }
+
+    return samples;
+}
+
+/**
+ * @brief Runs the hook manager benchmarks.
+ *
+ * @param samples The samples to benchmark against.
+ * @param results The list to append results to.
+ */
+void benchmark_hook_manager(const Samples& samples, std::vector<Result>& results) {
+    if (samples.functions.empty()) {
+        return;
+    }
+
+    // We don't have a real object to call these on, so just use the function itself
+    results.push_back(measure("preprocess_hook (unhooked)",
+                              samples.functions.size() * SAMPLE_LOOPS, [&samples]() -> size_t {
+                                  size_t hooked = 0;
+                                  for (size_t i = 0; i < SAMPLE_LOOPS; i++) {
+                                      for (auto func : samples.functions) {
+                                          auto list = hook_manager::impl::preprocess_hook(
+                                              L"Benchmark", func, func);
+                                          hooked += list == nullptr ? 0 : 1;
+                                      }
+                                  }
+                                  return hooked;
+                              }));
+
+    auto func = samples.functions.front();
+    auto func_name = func->get_path_name();
+    hook_manager::add_hook(func_name, hook_manager::Type::PRE, HOOK_IDENTIFIER,
+                           [](hook_manager::Details&) { return false; });
+
+    // Make sure we never leave the hook behind
+    const std::unique_ptr<std::wstring, void (*)(std::wstring*)> hook_guard{
+        &func_name, [](std::wstring* name) {
+            hook_manager::remove_hook(*name, hook_manager::Type::PRE, HOOK_IDENTIFIER);
+        }};
+
+    const size_t hooked_ops = MAX_SAMPLES * SAMPLE_LOOPS;
+    results.push_back(measure("preprocess_hook + run_hooks_of_type", hooked_ops, [func]() {
+        size_t blocked = 0;
+        for (size_t i = 0; i < hooked_ops; i++) {
+            auto list = hook_manager::impl::preprocess_hook(L"Benchmark", func, func);
+            if (list == nullptr) {
+                continue;
+            }
+
+            hook_manager::impl::ProcessEventArgs args{.func = func, .params = nullptr};
+            hook_manager::Details hook{
+                .obj = func,
+                .args = {&hook_manager::impl::ProcessEventArgs::extract, &args},
+                .ret = {func->find_return_param()},
+                .func = {.func = func, .object = func}};
+            blocked +=
+                hook_manager::impl::run_hooks_of_type(list, hook_manager::Type::PRE, hook) ? 1 : 0;
+        }
+        return blocked;
+    }));
+}
+
+/**
+ * @brief Runs the unreal type benchmarks.
+ *
+ * @param samples The samples to benchmark against.
+ * @param results The list to append results to.
+ */
+void benchmark_unreal(const Samples& samples, std::vector<Result>& results) {
+    results.push_back(
+        measure("UStruct::find_prop", samples.props.size() * SAMPLE_LOOPS, [&samples]() {
+            size_t found = 0;
+            for (size_t i = 0; i < SAMPLE_LOOPS; i++) {
+                for (const auto& [cls, name] : samples.props) {
+                    found += cls->find_prop(name) == nullptr ? 0 : 1;
+                }
+            }
+            return found;
+        }));
+
+    results.push_back(measure("WrappedStruct construct", samples.params.size(), [&samples]() {
+        size_t size = 0;
+        for (const auto& params : samples.params) {
+            const WrappedStruct copy{params.type};
+            size += copy.type->get_struct_size();
+        }
+        return size;
+    }));
+
+    results.push_back(measure("WrappedStruct copy", samples.params.size(), [&samples]() {
+        size_t size = 0;
+        for (const auto& params : samples.params) {
+            const WrappedStruct copy{params};
+            size += copy.type->get_struct_size();
+        }
+        return size;
+    }));
+
+    results.push_back(
+        measure("FName to std::string", samples.names.size() * SAMPLE_LOOPS, [&samples]() {
+            size_t size = 0;
+            for (size_t i = 0; i < SAMPLE_LOOPS; i++) {
+                for (auto name : samples.names) {
+                    size += ((std::string)name).size();
+                }
+            }
+            return size;
+        }));
+
+    results.push_back(
+        measure("FName std::format", samples.names.size() * SAMPLE_LOOPS, [&samples]() {
+            size_t size = 0;
+            for (size_t i = 0; i < SAMPLE_LOOPS; i++) {
+                for (auto name : samples.names) {
+                    size += std::format("{}", name).size();
+                }
+            }
+            return size;
+        }));
+
+    results.push_back(
+        measure("FName from std::wstring", samples.name_strs.size() * SAMPLE_LOOPS, [&samples]() {
+            size_t total = 0;
+            for (size_t i = 0; i < SAMPLE_LOOPS; i++) {
+                for (const auto& str : samples.name_strs) {
+                    const FName name{str};
+                    total += name == FName{} ? 0 : 1;
+                }
+            }
+            return total;
+        }));
+}
+
+/**
+ * @brief Runs the sigscan benchmarks.
+ *
+ * @param results The list to append results to.
+ */
+void benchmark_sigscan(std::vector<Result>& results) {
+    // Use patterns which should never match, so we always scan the entire range
+    // D6 is an invalid instruction in x64, and undocumented in x86, so should be very rare
+    std::array<std::array<uint8_t, 16>, BATCH_PATTERN_COUNT> bytes{};
+    std::array<uint8_t, 16> mask{};
+    mask.fill(0xFF);  // NOLINT(readability-magic-numbers)
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes.at(i) = {0xD6, 0x0F, 0x0B, 0xD6, 0xF4, 0x17, 0xD6, 0x0F,  // NOLINT
+                       0x0B, 0xD6, 0xF4, 0x17, 0xD6, 0x0F, 0x0B, static_cast<uint8_t>(i)};
+    }
+
+    std::vector<PatternView> patterns{};
+    for (const auto& pattern : bytes) {
+        patterns.push_back({.bytes = pattern.data(),
+                            .mask = mask.data(),
+                            .size = mask.size(),
+                            .section = Section::CODE});
+    }
+
+    results.push_back(measure("sigscan (code, not found)", 1, [&bytes, &mask]() {
+        return sigscan(bytes.front().data(), mask.data(), mask.size(), Section::CODE);
+    }));
+
+    results.push_back(measure("sigscan_batch (code, 16 not found)", 1, [&patterns]() {
+        size_t found = 0;
+        for (auto addr : sigscan_batch(patterns)) {
+            found += addr == 0 ? 0 : 1;
+        }
+        return found;
+    }));
+}
+
+/**
+ * @brief Escapes a string for use in JSON.
+ *
+ * @param str The string to escape.
+ * @return The escaped string.
+ */
+std::string json_escape(std::string_view str) {
+    std::string escaped{};
+    escaped.reserve(str.size());
+    for (auto chr : str) {
+        if (chr == '"' || chr == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(chr);
+    }
+    return escaped;
+}
+
+/**
+ * @brief Writes the benchmark results to a file, as JSON.
+ *
+ * @param path The file to write to.
+ * @param samples The samples which were benchmarked against.
+ * @param results The results.
+ */
+void write_results(const std::filesystem::path& path,
+                   const Samples& samples,
+                   const std::vector<Result>& results) {
+    std::ofstream stream{path, std::ofstream::trunc};
+
+#if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW
+    const std::string_view flavour = "willow";
+#elif UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK
+    const std::string_view flavour = "oak";
+#else
+#error Unknown SDK flavour
+#endif
+
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+
+    stream << "{\n";
+    stream << std::format("  \"version\": \"{}\",\n", json_escape(get_version_string()));
+    stream << std::format("  \"flavour\": \"{}\",\n", flavour);
+    stream << std::format("  \"unix_time_ms\": {},\n", now);
+    stream << "  \"samples\": {\n";
+    stream << std::format("    \"gobjects\": {},\n", gobjects().size());
+    stream << std::format("    \"functions\": {},\n", samples.functions.size());
+    stream << std::format("    \"classes\": {},\n", samples.classes.size());
+    stream << std::format("    \"props\": {},\n", samples.props.size());
+    stream << std::format("    \"names\": {}\n", samples.names.size());
+    stream << "  },\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        stream << std::format(
+            "    {{\"name\": \"{}\", \"ops\": {}, \"mean_ns_per_op\": {:.3f}, "
+            "\"best_ns_per_op\": {:.3f}}}{}\n",
+            json_escape(result.name), result.ops, result.mean_ns_per_op, result.best_ns_per_op,
+            i + 1 == results.size() ? "" : ",");
+    }
+    stream << "  ]\n";
+    stream << "}\n";
+}
+
+/**
+ * @brief Callback for the benchmark console command.
+ */
+void command_callback(const wchar_t* /*line*/, size_t /*size*/, size_t /*cmd_len*/) {
+    try {
+        benchmark::run();
+    } catch (const std::exception& ex) {
+        LOG(ERROR, "Benchmark failed: {}", ex.what());
+    }
+}
+
+}  // namespace
+
+void run(void) {
+    auto path = utils::get_this_dll().parent_path()
+                / config::get_str("unrealsdk.benchmark_file").value_or("unrealsdk.benchmark.json");
+
+    LOG(INFO, "Running benchmarks...");
+    auto samples = gather_samples();
+
+    std::vector<Result> results{};
+    benchmark_hook_manager(samples, results);
+    benchmark_unreal(samples, results);
+    benchmark_sigscan(results);
+
+    write_results(path, samples, results);
+    LOG(INFO, "Wrote benchmark results to {}", path.string());
+}
+
+void init(void) {
+    auto command =
+        config::get_str("unrealsdk.benchmark_command").value_or("unrealsdk_benchmark");
+    if (!command.empty()) {
+        commands::add_command(utils::widen(command), &command_callback);
+    }
+}
+
+}  // namespace impl
+#endif
+#pragma endregion
+
+// =================================================================================================
+
+#pragma region Public Interface
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, benchmark_run);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, benchmark_run) {
+    impl::run();
+}
+#endif
+void run(void) {
+    UNREALSDK_MANGLE(benchmark_run)();
+}
+
+#pragma endregion
+
+}  // namespace unrealsdk::benchmark
@@ -0,0 +1,38 @@
+#ifndef UNREALSDK_BENCHMARK_H
+#define UNREALSDK_BENCHMARK_H
+
+#include "unrealsdk/pch.h"
+
+namespace unrealsdk::benchmark {
+
+/*
+A set of micro benchmarks over the sdk's hot paths, run against the live game.
+
+Rather than mocking the engine, these sample real objects out of GObjects, so they measure the
+actual object graphs, name table, and executable the sdk runs against. Results are written as JSON,
+so they can be compared between builds, and a summary is logged.
+
+Since these run inside the game, they should be run from a quiet spot (e.g. the main menu), and
+compared against results from the same spot.
+*/
+
+/**
+ * @brief Runs all benchmarks, writing the results to the file given by `unrealsdk.benchmark_file`.
+ * @note Should be run from the game thread. Temporarily adds a hook.
+ */
+void run(void);
+
+#ifndef UNREALSDK_IMPORTING
+namespace impl {
+
+/**
+ * @brief Registers the benchmark console command.
+ */
+void init(void);
+
+}  // namespace impl
+#endif
+
+}  // namespace unrealsdk::benchmark
+
+#endif /* UNREALSDK_BENCHMARK_H */
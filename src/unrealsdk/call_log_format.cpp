@@ -0,0 +1,78 @@
+// Deliberately not using the pch, see the header
+#include "unrealsdk/call_log_format.h"
+
+namespace unrealsdk::hook_manager::impl::call_log {
+
+void write_varint(std::vector<uint8_t>& data, uint64_t value) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    while (value >= 0x80) {
+        data.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    // NOLINTEND(readability-magic-numbers)
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+void write_pointer_delta(std::vector<uint8_t>& data, uintptr_t& last, uintptr_t value) {
+    // Userspace pointers never use the top bit, so this won't overflow
+    auto delta = static_cast<int64_t>(value) - static_cast<int64_t>(last);
+    last = value;
+
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    write_varint(data, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+}
+
+void write_file_header(std::vector<uint8_t>& data) {
+    data.insert(data.end(), MAGIC.begin(), MAGIC.end());
+    write_raw(data, VERSION);
+}
+
+void Block::reserve(size_t size) {
+    this->payload.reserve(size);
+}
+
+size_t Block::size(void) const {
+    return this->payload.size();
+}
+
+void Block::reset(uint64_t now) {
+    this->payload.clear();
+    this->base_time = now;
+    this->last_time = now;
+    this->last_source = 0;
+    this->last_func = 0;
+    this->last_obj = 0;
+}
+
+void Block::write_name(uintptr_t ptr, std::wstring_view name) {
+    write_varint(this->payload, static_cast<uint64_t>(EntryTag::NAME));
+    write_varint(this->payload, ptr);
+    write_varint(this->payload, name.size());
+    for (auto chr : name) {
+        write_raw(this->payload, static_cast<uint16_t>(chr));
+    }
+}
+
+void Block::write_call(uint64_t now, uintptr_t source, uintptr_t func, uintptr_t obj) {
+    write_varint(this->payload, static_cast<uint64_t>(EntryTag::CALL));
+    write_varint(this->payload, now - this->last_time);
+    this->last_time = now;
+    write_pointer_delta(this->payload, this->last_source, source);
+    write_pointer_delta(this->payload, this->last_func, func);
+    write_pointer_delta(this->payload, this->last_obj, obj);
+}
+
+std::vector<uint8_t> Block::header(uint32_t thread_id) const {
+    std::vector<uint8_t> header{};
+    write_raw(header, BLOCK_TYPE_CALLS);
+    write_raw(header, thread_id);
+    write_raw(header, this->base_time);
+    write_raw(header, static_cast<uint32_t>(this->payload.size()));
+    return header;
+}
+
+const std::vector<uint8_t>& Block::data(void) const {
+    return this->payload;
+}
+
+}  // namespace unrealsdk::hook_manager::impl::call_log
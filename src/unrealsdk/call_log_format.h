@@ -0,0 +1,171 @@
+#ifndef UNREALSDK_CALL_LOG_FORMAT_H
+#define UNREALSDK_CALL_LOG_FORMAT_H
+
+// Like the pattern search, this deliberately doesn't rely on the pch, so it can be tested natively
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace unrealsdk::hook_manager::impl {
+
+/*
+The binary format used by `log_all_calls`, when `unrealsdk.log_all_calls_format` is set to binary.
+Use `tools/decode_call_log.py` to convert a log back into TSV.
+
+All integers are little endian. The file starts with a header:
+    char[8]  magic, "USDKCALL"
+    uint32   format version, currently 1
+
+Followed by any number of blocks:
+    uint8    block type, currently always 1
+    uint32   thread id
+    uint64   base timestamp, in nanoseconds since logging started
+    uint32   payload size, in bytes
+    uint8[]  payload
+
+The payload is a sequence of entries, each starting with a varint tag:
+    0 = call
+        varint   time since the previous call in this block, or since the base timestamp
+        zvarint  source pointer, as a delta from the previous call in this block
+        zvarint  function pointer, as a delta from the previous call in this block
+        zvarint  object pointer, as a delta from the previous call in this block
+    1 = name
+        varint   pointer
+        varint   length, in utf-16 code units
+        uint16[] the name - a source name (e.g. "ProcessEvent"), or an object's full path name
+
+Varints are LEB128, zvarints are zigzag encoded LEB128. Since consecutive calls tend to be on nearby
+functions and objects, deltas usually fit in only a couple of bytes each. Deltas are reset at the
+start of every block, so each block is self-contained, but names are tracked per thread. A name
+always appears before any call using it in that thread's blocks, and later names for the same
+pointer replace earlier ones.
+*/
+
+namespace call_log {
+
+const constexpr std::array<char, 8> MAGIC = {'U', 'S', 'D', 'K', 'C', 'A', 'L', 'L'};
+const constexpr uint32_t VERSION = 1;
+const constexpr uint8_t BLOCK_TYPE_CALLS = 1;
+
+enum class EntryTag : uint8_t {
+    CALL = 0,
+    NAME = 1,
+};
+
+/**
+ * @brief Writes an integer to a byte buffer, in raw little endian form.
+ *
+ * @tparam T The type of integer to write.
+ * @param data The buffer to write to.
+ * @param value The value to write.
+ */
+template <typename T>
+void write_raw(std::vector<uint8_t>& data, T value) {
+    static_assert(std::endian::native == std::endian::little);
+    auto offset = data.size();
+    data.resize(offset + sizeof(T));
+    memcpy(&data[offset], &value, sizeof(T));
+}
+
+/**
+ * @brief Writes an integer to a byte buffer, as a varint.
+ *
+ * @param data The buffer to write to.
+ * @param value The value to write.
+ */
+void write_varint(std::vector<uint8_t>& data, uint64_t value);
+
+/**
+ * @brief Writes the difference between two pointers to a byte buffer, as a zigzag varint.
+ *
+ * @param data The buffer to write to.
+ * @param last The previous pointer value. Updated to the new value.
+ * @param value The new pointer value.
+ */
+void write_pointer_delta(std::vector<uint8_t>& data, uintptr_t& last, uintptr_t value);
+
+/**
+ * @brief Writes the file header.
+ *
+ * @param data The buffer to write to.
+ */
+void write_file_header(std::vector<uint8_t>& data);
+
+/**
+ * @brief A single block of calls, as it's being built.
+ */
+class Block {
+   private:
+    std::vector<uint8_t> payload;
+
+    uint64_t base_time = 0;
+    uint64_t last_time = 0;
+    uintptr_t last_source = 0;
+    uintptr_t last_func = 0;
+    uintptr_t last_obj = 0;
+
+   public:
+    /**
+     * @brief Reserves space for the payload.
+     *
+     * @param size The amount of bytes to reserve.
+     */
+    void reserve(size_t size);
+
+    /**
+     * @brief Gets the size of the payload written so far.
+     *
+     * @return The size, in bytes.
+     */
+    [[nodiscard]] size_t size(void) const;
+
+    /**
+     * @brief Starts a new block, clearing the payload and resetting all deltas.
+     *
+     * @param now The current time, in nanoseconds since logging started.
+     */
+    void reset(uint64_t now);
+
+    /**
+     * @brief Writes a name entry.
+     *
+     * @param ptr The pointer being named.
+     * @param name The name. Each character is truncated to a utf-16 code unit.
+     */
+    void write_name(uintptr_t ptr, std::wstring_view name);
+
+    /**
+     * @brief Writes a call entry.
+     *
+     * @param now The current time, in nanoseconds since logging started.
+     * @param source The source pointer.
+     * @param func The function pointer.
+     * @param obj The object pointer.
+     */
+    void write_call(uint64_t now, uintptr_t source, uintptr_t func, uintptr_t obj);
+
+    /**
+     * @brief Gets the header to write before this block's payload.
+     *
+     * @param thread_id The id of the thread this block was recorded on.
+     * @return The header bytes.
+     */
+    [[nodiscard]] std::vector<uint8_t> header(uint32_t thread_id) const;
+
+    /**
+     * @brief Gets the payload written so far.
+     *
+     * @return The payload bytes.
+     */
+    [[nodiscard]] const std::vector<uint8_t>& data(void) const;
+};
+
+}  // namespace call_log
+
+}  // namespace unrealsdk::hook_manager::impl
+
+#endif /* UNREALSDK_CALL_LOG_FORMAT_H */
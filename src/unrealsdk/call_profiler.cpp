@@ -0,0 +1,568 @@
+#include "unrealsdk/pch.h"
+
+#include "unrealsdk/call_profiler.h"
+#include "unrealsdk/commands.h"
+#include "unrealsdk/config.h"
+#include "unrealsdk/unreal/classes/ufunction.h"
+#include "unrealsdk/unreal/classes/uobject.h"
+#include "unrealsdk/unreal/structs/fname.h"
+#include "unrealsdk/unreal/wrappers/gnames.h"
+#include "unrealsdk/unrealsdk.h"
+#include "unrealsdk/utils.h"
+
+using namespace unrealsdk::unreal;
+
+namespace unrealsdk::call_profiler {
+
+#pragma region Implementation
+#ifndef UNREALSDK_IMPORTING
+namespace impl {
+
+/*
+Calls are made from multiple threads at once, so to avoid every call fighting over a shared table,
+each thread counts calls in it's own table. Each table has it's own mutex, but since this is only
+contended while someone's collecting the results, locking it is very cheap.
+
+Rather than clearing every thread's table when resetting, we bump a generation counter, and tables
+clear themselves the next time they're used. Filters work similarly, each entry remembers the
+filter generation it was last checked against.
+*/
+
+std::atomic<bool> enabled{false};
+
+namespace {
+
+std::atomic<uint32_t> sample_rate{0};
+std::atomic<uint32_t> reset_generation{0};
+// Starts ahead of the entries, so that they always get checked on first use
+std::atomic<uint32_t> filter_generation{1};
+
+struct Filters {
+    std::vector<FName> include;
+    std::vector<FName> exclude;
+
+    // Also keep the original strings, so the console command can modify one list at a time
+    std::vector<std::wstring> include_strs;
+    std::vector<std::wstring> exclude_strs;
+};
+
+std::shared_mutex filters_mutex{};
+Filters filters{};
+
+/**
+ * @brief Checks if any of a function's outers have one of the given names.
+ *
+ * @param func The function to check.
+ * @param names The names to look for.
+ * @return True if any outer matched.
+ */
+bool outer_matches(const UFunction* func, const std::vector<FName>& names) {
+    for (const UObject* outer = func->Outer(); outer != nullptr; outer = outer->Outer()) {
+        if (std::ranges::find(names, outer->Name()) != names.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks if a function should be profiled under the current filters.
+ *
+ * @param func The function to check.
+ * @return True if the function should be profiled.
+ */
+bool is_included(const UFunction* func) {
+    const std::shared_lock lock(filters_mutex);
+    // Check the strings, so that an include list made entirely of unknown names matches nothing
+    return (filters.include_strs.empty() || outer_matches(func, filters.include))
+           && !outer_matches(func, filters.exclude);
+}
+
+/**
+ * @brief Adds one set of results into another.
+ *
+ * @param dest The results to add to.
+ * @param src The results to add.
+ */
+void merge_profile(FunctionProfile& dest, const FunctionProfile& src) {
+    dest.calls += src.calls;
+    dest.hooked_calls += src.hooked_calls;
+    dest.sampled_calls += src.sampled_calls;
+    dest.sampled_time_ns += src.sampled_time_ns;
+}
+
+class ThreadTable;
+
+std::mutex all_tables_mutex{};
+std::unordered_set<ThreadTable*> all_tables{};
+// Results from threads which have since exited
+std::unordered_map<const UFunction*, FunctionProfile> retired_results{};
+
+class ThreadTable {
+   private:
+    struct Entry {
+        FunctionProfile profile;
+        uint32_t filter_generation = 0;
+        bool included = false;
+    };
+
+    std::mutex mutex;
+    uint32_t generation = 0;
+    uint32_t calls_since_sample = 0;
+    std::unordered_map<const UFunction*, Entry> entries;
+
+    /**
+     * @brief Merges this thread's results into a combined set.
+     * @note Assumes both this table's mutex and the all tables mutex are held.
+     *
+     * @param results The results to merge into.
+     */
+    void merge_into_locked(std::unordered_map<const UFunction*, FunctionProfile>& results) const {
+        if (this->generation != reset_generation.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        for (const auto& [func, entry] : this->entries) {
+            if (entry.profile.calls == 0) {
+                continue;
+            }
+            auto [iter, inserted] = results.try_emplace(func, entry.profile);
+            if (!inserted) {
+                merge_profile(iter->second, entry.profile);
+            }
+        }
+    }
+
+   public:
+    ThreadTable(void) {
+        const std::lock_guard<std::mutex> lock(all_tables_mutex);
+        all_tables.insert(this);
+    }
+
+    ThreadTable(const ThreadTable&) = delete;
+    ThreadTable(ThreadTable&&) = delete;
+    ThreadTable& operator=(const ThreadTable&) = delete;
+    ThreadTable& operator=(ThreadTable&&) = delete;
+
+    ~ThreadTable() {
+        const std::lock_guard<std::mutex> all_lock(all_tables_mutex);
+        all_tables.erase(this);
+
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->merge_into_locked(retired_results);
+    }
+
+    /**
+     * @brief Records a call to a function.
+     *
+     * @param func The function which was called.
+     * @param hooked True if the call matched at least one hook.
+     * @return True if this call should be timed.
+     */
+    bool record(const UFunction* func, bool hooked) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto current_generation = reset_generation.load(std::memory_order_relaxed);
+        if (this->generation != current_generation) {
+            this->generation = current_generation;
+            this->entries.clear();
+        }
+
+        auto& entry = this->entries[func];
+        auto current_filter_generation = filter_generation.load(std::memory_order_relaxed);
+        if (entry.filter_generation != current_filter_generation) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            entry.profile.func = const_cast<UFunction*>(func);
+            entry.filter_generation = current_filter_generation;
+            entry.included = is_included(func);
+        }
+        if (!entry.included) {
+            return false;
+        }
+
+        entry.profile.calls++;
+        if (hooked) {
+            entry.profile.hooked_calls++;
+        }
+
+        auto rate = sample_rate.load(std::memory_order_relaxed);
+        if (rate == 0 || ++this->calls_since_sample < rate) {
+            return false;
+        }
+        this->calls_since_sample = 0;
+        return true;
+    }
+
+    /**
+     * @brief Records the time taken by a timed call.
+     *
+     * @param func The function which was called.
+     * @param time The time the call took.
+     */
+    void record_time(const UFunction* func, std::chrono::nanoseconds time) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+
+        // If we got reset mid call, just drop it
+        auto entry = this->entries.find(func);
+        if (entry == this->entries.end()
+            || this->generation != reset_generation.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        entry->second.profile.sampled_calls++;
+        entry->second.profile.sampled_time_ns += static_cast<uint64_t>(time.count());
+    }
+
+    /**
+     * @brief Merges this thread's results into a combined set.
+     * @note Assumes the all tables mutex is held.
+     *
+     * @param results The results to merge into.
+     */
+    void merge_into(std::unordered_map<const UFunction*, FunctionProfile>& results) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->merge_into_locked(results);
+    }
+};
+
+thread_local ThreadTable thread_table{};
+
+/**
+ * @brief Sets the profiling filters.
+ *
+ * @param include The functions to include.
+ * @param exclude The functions to exclude.
+ */
+void set_filters(std::span<const std::wstring_view> include,
+                 std::span<const std::wstring_view> exclude) {
+    // Look up existing names rather than constructing FNames, which would add any typos to the
+    // engine's name table. Since no outer can currently have a name which doesn't exist, we can
+    // drop it - but keep its string, so it gets looked up again the next time filters are set.
+    auto add_names = [](std::span<const std::wstring_view> names, std::vector<FName>& fnames,
+                        std::vector<std::wstring>& strs) {
+        for (auto name : names) {
+            strs.emplace_back(name);
+
+            auto fname = unrealsdk::gnames().find(name);
+            if (fname.has_value()) {
+                fnames.push_back(*fname);
+            } else {
+                LOG(WARNING, L"Call profiler filter '{}' doesn't match any existing name", name);
+            }
+        }
+    };
+
+    Filters new_filters{};
+    add_names(include, new_filters.include, new_filters.include_strs);
+    add_names(exclude, new_filters.exclude, new_filters.exclude_strs);
+
+    {
+        const std::unique_lock lock(filters_mutex);
+        filters = std::move(new_filters);
+    }
+    filter_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the current profiling results.
+ *
+ * @return The results, sorted by descending call count.
+ */
+std::vector<FunctionProfile> get_results(void) {
+    std::unordered_map<const UFunction*, FunctionProfile> merged{};
+    {
+        const std::lock_guard<std::mutex> lock(all_tables_mutex);
+        merged = retired_results;
+        for (auto table : all_tables) {
+            table->merge_into(merged);
+        }
+    }
+
+    std::vector<FunctionProfile> results{};
+    results.reserve(merged.size());
+    for (const auto& [func, profile] : merged) {
+        results.push_back(profile);
+    }
+    std::ranges::sort(results, std::greater{}, &FunctionProfile::calls);
+    return results;
+}
+
+/**
+ * @brief Clears all profiling results.
+ */
+void reset(void) {
+    const std::lock_guard<std::mutex> lock(all_tables_mutex);
+    retired_results.clear();
+    reset_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+#pragma region Console Command
+
+const constexpr size_t DEFAULT_TOP_COUNT = 20;
+const constexpr double NS_PER_US = 1000.0;
+
+/**
+ * @brief Gets the estimated total time spent in a function, extrapolated from it's timed calls.
+ *
+ * @param profile The function's profile.
+ * @return The estimated total time, in nanoseconds.
+ */
+double estimated_total_time(const FunctionProfile& profile) {
+    if (profile.sampled_calls == 0) {
+        return 0;
+    }
+    return static_cast<double>(profile.sampled_time_ns) * static_cast<double>(profile.calls)
+           / static_cast<double>(profile.sampled_calls);
+}
+
+/**
+ * @brief Prints the hottest functions to console.
+ *
+ * @param count How many functions to print.
+ * @param by_time True to sort by estimated total time, false to sort by call count.
+ */
+void print_top(size_t count, bool by_time) {
+    auto results = get_results();
+    if (by_time) {
+        std::ranges::sort(results, std::greater{}, &estimated_total_time);
+    }
+    count = std::min(count, results.size());
+
+    LOG(INFO, "Top {} of {} profiled functions, by {}:", count, results.size(),
+        by_time ? "estimated time" : "call count");
+    LOG(INFO, "{:>12} {:>12} {:>12} {:>12} {}", "Calls", "Hooked", "Avg Time", "Est. Total",
+        "Function");
+
+    for (const auto& profile : std::span{results}.first(count)) {
+        std::wstring avg_time = L"-";
+        std::wstring total_time = L"-";
+        if (profile.sampled_calls > 0) {
+            avg_time = std::format(L"{:.2f}us", static_cast<double>(profile.sampled_time_ns)
+                                                    / static_cast<double>(profile.sampled_calls)
+                                                    / NS_PER_US);
+            total_time = std::format(L"{:.0f}us", estimated_total_time(profile) / NS_PER_US);
+        }
+
+        LOG(INFO, L"{:>12} {:>12} {:>12} {:>12} {}", profile.calls, profile.hooked_calls, avg_time,
+            total_time, profile.func->get_path_name());
+    }
+}
+
+/**
+ * @brief Callback for the profiling console command.
+ *
+ * @param line The full line which triggered the callback.
+ * @param size The number of characters in the line.
+ * @param cmd_len The length of the matched command.
+ */
+void command_callback(const wchar_t* line, size_t size, size_t cmd_len) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::wistringstream args{std::wstring{line + cmd_len, size - cmd_len}};
+
+    std::wstring action{};
+    args >> action;
+    std::ranges::transform(action, action.begin(), &std::towlower);
+
+    if (action == L"start") {
+        uint32_t rate{};
+        if (args >> rate) {
+            sample_rate = rate;
+        }
+        enabled = true;
+        LOG(INFO, "Started profiling calls, timing one in every {} calls", sample_rate.load());
+    } else if (action == L"stop") {
+        enabled = false;
+        LOG(INFO, "Stopped profiling calls");
+    } else if (action == L"reset") {
+        reset();
+        LOG(INFO, "Reset call profile");
+    } else if (action == L"top") {
+        size_t count{};
+        if (!(args >> count)) {
+            count = DEFAULT_TOP_COUNT;
+            args.clear();
+        }
+        std::wstring order{};
+        args >> order;
+        print_top(count, order == L"time");
+    } else if (action == L"include" || action == L"exclude") {
+        std::vector<std::wstring> names{std::istream_iterator<std::wstring, wchar_t>{args},
+                                        std::istream_iterator<std::wstring, wchar_t>{}};
+
+        std::vector<std::wstring> include_strs{};
+        std::vector<std::wstring> exclude_strs{};
+        {
+            const std::shared_lock lock(filters_mutex);
+            include_strs = filters.include_strs;
+            exclude_strs = filters.exclude_strs;
+        }
+        (action == L"include" ? include_strs : exclude_strs) = std::move(names);
+
+        const std::vector<std::wstring_view> include_views{include_strs.begin(),
+                                                           include_strs.end()};
+        const std::vector<std::wstring_view> exclude_views{exclude_strs.begin(),
+                                                           exclude_strs.end()};
+        set_filters(include_views, exclude_views);
+        LOG(INFO, "Updated call profile filters");
+    } else {
+        LOG(INFO, "Usage:");
+        LOG(INFO, "  start [sample rate]   Starts profiling, optionally setting the sample rate");
+        LOG(INFO, "  stop                  Stops profiling, keeping the results");
+        LOG(INFO, "  reset                 Clears the results");
+        LOG(INFO, "  top [count] [time]    Prints the hottest functions, by calls or time");
+        LOG(INFO, "  include [names...]    Only profiles functions with one of these outers");
+        LOG(INFO, "  exclude [names...]    Ignores functions with one of these outers");
+    }
+}
+
+#pragma endregion
+
+}  // namespace
+
+Sample record_call(const UFunction* func, bool hooked) {
+    if (!thread_table.record(func, hooked)) {
+        return {};
+    }
+    return {.func = func, .start = std::chrono::steady_clock::now()};
+}
+
+void finish_sample(const Sample& sample) {
+    thread_table.record_time(sample.func, std::chrono::steady_clock::now() - sample.start);
+}
+
+void init(void) {
+    auto command = config::get_str("unrealsdk.profile_calls_command")
+                       .value_or("unrealsdk_profile_calls");
+    if (!command.empty()) {
+        commands::add_command(utils::widen(command), &command_callback);
+    }
+
+    sample_rate = config::get_int<uint32_t>("unrealsdk.profile_calls_sample_rate").value_or(0);
+}
+
+}  // namespace impl
+#endif
+#pragma endregion
+
+// =================================================================================================
+
+#pragma region Public Interface
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, call_profiler_profile_calls, bool should_profile);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, call_profiler_profile_calls, bool should_profile) {
+    impl::enabled = should_profile;
+}
+#endif
+void profile_calls(bool should_profile) {
+    UNREALSDK_MANGLE(call_profiler_profile_calls)(should_profile);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, call_profiler_set_sample_rate, uint32_t rate);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, call_profiler_set_sample_rate, uint32_t rate) {
+    impl::sample_rate = rate;
+}
+#endif
+void set_sample_rate(uint32_t rate) {
+    UNREALSDK_MANGLE(call_profiler_set_sample_rate)(rate);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void,
+               call_profiler_set_filters,
+               const wchar_t* const* include,
+               const size_t* include_sizes,
+               size_t include_count,
+               const wchar_t* const* exclude,
+               const size_t* exclude_sizes,
+               size_t exclude_count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void,
+               call_profiler_set_filters,
+               const wchar_t* const* include,
+               const size_t* include_sizes,
+               size_t include_count,
+               const wchar_t* const* exclude,
+               const size_t* exclude_sizes,
+               size_t exclude_count) {
+    std::vector<std::wstring_view> include_views{};
+    std::vector<std::wstring_view> exclude_views{};
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (size_t i = 0; i < include_count; i++) {
+        include_views.emplace_back(include[i], include_sizes[i]);
+    }
+    for (size_t i = 0; i < exclude_count; i++) {
+        exclude_views.emplace_back(exclude[i], exclude_sizes[i]);
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    impl::set_filters(include_views, exclude_views);
+}
+#endif
+void set_filters(std::span<const std::wstring_view> include,
+                 std::span<const std::wstring_view> exclude) {
+    std::vector<const wchar_t*> include_strs{};
+    std::vector<size_t> include_sizes{};
+    for (auto name : include) {
+        include_strs.push_back(name.data());
+        include_sizes.push_back(name.size());
+    }
+
+    std::vector<const wchar_t*> exclude_strs{};
+    std::vector<size_t> exclude_sizes{};
+    for (auto name : exclude) {
+        exclude_strs.push_back(name.data());
+        exclude_sizes.push_back(name.size());
+    }
+
+    UNREALSDK_MANGLE(call_profiler_set_filters)(include_strs.data(), include_sizes.data(),
+                                                include.size(), exclude_strs.data(),
+                                                exclude_sizes.data(), exclude.size());
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] FunctionProfile*, call_profiler_get_results, size_t& size);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] FunctionProfile*, call_profiler_get_results, size_t& size) {
+    auto results = impl::get_results();
+    size = results.size();
+
+    auto mem = u_malloc<FunctionProfile>(std::max<size_t>(size, 1) * sizeof(FunctionProfile));
+    std::ranges::copy(results, mem);
+
+    return mem;
+}
+#endif
+std::vector<FunctionProfile> get_results(void) {
+    size_t size{};
+    auto ptr = UNREALSDK_MANGLE(call_profiler_get_results)(size);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::vector<FunctionProfile> results{ptr, ptr + size};
+    u_free(ptr);
+    return results;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, call_profiler_reset);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, call_profiler_reset) {
+    impl::reset();
+}
+#endif
+void reset(void) {
+    UNREALSDK_MANGLE(call_profiler_reset)();
+}
+
+#pragma endregion
+
+}  // namespace unrealsdk::call_profiler
@@ -0,0 +1,122 @@
+#ifndef UNREALSDK_CALL_PROFILER_H
+#define UNREALSDK_CALL_PROFILER_H
+
+#include "unrealsdk/pch.h"
+
+namespace unrealsdk::unreal {
+
+class UFunction;
+
+}  // namespace unrealsdk::unreal
+
+namespace unrealsdk::call_profiler {
+
+/*
+A lightweight alternative to `hook_manager::log_all_calls`, which only counts how many times each
+unreal function gets called, rather than writing out every single call.
+
+While enabled, every call passing through the hook manager is counted, whether it's hooked or not.
+Optionally, one in every N calls can also be timed, to estimate which functions take the most time.
+Timings are inclusive, they include any nested calls the function makes.
+
+The results can be limited to only specific functions using include/exclude filters. A filter
+matches a function if it's the name of any of the function's outers - i.e. it's class, state, or
+package.
+
+Everything can also be controlled using the console command given by the
+`unrealsdk.profile_calls_command` setting.
+*/
+
+struct FunctionProfile {
+    /// The function which was called.
+    /// Results are keyed by pointer, the function is only guaranteed to be alive while profiling.
+    unreal::UFunction* func;
+    /// How many times the function was called.
+    uint64_t calls;
+    /// How many of those calls matched at least one hook.
+    uint64_t hooked_calls;
+    /// How many calls were timed.
+    uint64_t sampled_calls;
+    /// The total time taken by all timed calls.
+    uint64_t sampled_time_ns;
+};
+
+/**
+ * @brief Toggles profiling unreal function calls.
+ *
+ * @param should_profile True to start profiling, false to stop it. Stopping keeps all results.
+ */
+void profile_calls(bool should_profile);
+
+/**
+ * @brief Sets how often calls are timed.
+ *
+ * @param rate Time one in every this many calls on each thread. 0 disables timing.
+ */
+void set_sample_rate(uint32_t rate);
+
+/**
+ * @brief Sets which functions are profiled.
+ * @note Functions which were already profiled keep their results.
+ * @note Filters which don't match any existing name are logged and ignored, they never add new
+ *       names. An include list made up entirely of unknown names matches nothing.
+ *
+ * @param include If not empty, only functions matching one of these filters are profiled.
+ * @param exclude Functions matching any of these filters are not profiled.
+ */
+void set_filters(std::span<const std::wstring_view> include,
+                 std::span<const std::wstring_view> exclude);
+
+/**
+ * @brief Gets the current profiling results.
+ *
+ * @return The results for every function which was called, sorted by descending call count.
+ */
+[[nodiscard]] std::vector<FunctionProfile> get_results(void);
+
+/**
+ * @brief Clears all profiling results.
+ */
+void reset(void);
+
+#ifndef UNREALSDK_IMPORTING
+namespace impl {  // These functions are only relevant when implementing a hook manager
+
+/// A call which is being timed.
+struct Sample {
+    const unreal::UFunction* func = nullptr;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// If profiling is currently enabled - checked before calling anything else.
+extern std::atomic<bool> enabled;
+
+/**
+ * @brief Records a call to a function.
+ *
+ * @param func The function which was called.
+ * @param hooked True if the call matched at least one hook.
+ * @return If this call should be timed, the sample to pass to `finish_sample` once the call
+ *         completes. Otherwise, a sample with a null function.
+ */
+Sample record_call(const unreal::UFunction* func, bool hooked);
+
+/**
+ * @brief Records the time taken by a timed call.
+ * @note Must be called on the same thread which recorded the call.
+ *
+ * @param sample The sample returned by `record_call`.
+ */
+void finish_sample(const Sample& sample);
+
+/**
+ * @brief Registers the profiling console command.
+ */
+void init(void);
+
+}  // namespace impl
+#endif
+
+}  // namespace unrealsdk::call_profiler
+
+#endif /* UNREALSDK_CALL_PROFILER_H */
@@ -14,10 +14,15 @@ using namespace unrealsdk::unreal;
 namespace unrealsdk::game {
 
 void BL1Hook::hook(void) {
-    wait_for_steam_drm();
+    const bool unpacked = wait_for_steam_drm();
 
     hook_antidebug();
 
+    // Find all our sigscans in one go, the individual functions just pick up the cached results
+    // Must be done after steam drm, since it changes the contents of the exe. If we're not sure
+    // it's finished, don't trust any misses enough to cache them.
+    prescan(unpacked);
+
     hook_process_event();
     hook_call_function();
 
@@ -33,6 +38,8 @@ void BL1Hook::hook(void) {
 
     hexedit_set_command();
     hexedit_array_limit();
+
+    clear_prescan();
 }
 
 void BL1Hook::post_init(void) {
@@ -54,6 +61,7 @@ const constinit Pattern<11> GNATIVES_SIG{
     "57"                   // push edi
     "8D 4D ??"             // lea ecx, [ebp-44]
 };
+const PatternRegistration GNATIVES_SIG_REGISTRATION{"GNATIVES_SIG", GNATIVES_SIG};
 
 // NOLINTNEXTLINE(modernize-use-using)
 typedef void(__thiscall* fframe_step_func)(UObject*, FFrame*, void*);
@@ -105,6 +113,7 @@ const constinit Pattern<72> FNAME_INIT_SIG{
     "8B E9"              // mov ebp, ecx
     "89 6C 24 ??"        // mov [esp+1C], ebp
 };
+const PatternRegistration FNAME_INIT_SIG_REGISTRATION{"FNAME_INIT_SIG", FNAME_INIT_SIG};
 
 // NOLINTNEXTLINE(modernize-use-using)
 typedef void(__thiscall* fname_init_func)(FName* name,
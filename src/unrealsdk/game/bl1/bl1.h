@@ -14,8 +14,11 @@ class BL1Hook : public AbstractHook {
    protected:
     /**
      * @brief Blocking waits for the steam drm to finish unpacking the executable.
+     *
+     * @return True if the executable is known to be unpacked, false if we had to fall back to
+     *         waiting a fixed delay.
      */
-    static void wait_for_steam_drm(void);
+    static bool wait_for_steam_drm(void);
 
     /**
      * @brief Finds `FName::Init`, and sets up such that `fname_init` may be called.
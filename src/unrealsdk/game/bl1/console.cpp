@@ -46,6 +46,10 @@ const constexpr auto INJECT_CONSOLE_TYPE = hook_manager::Type::PRE;
 const std::wstring INJECT_CONSOLE_ID = L"unrealsdk_bl1_inject_console";
 
 BoundFunction console_output_text{};
+// Output text gets called for every console line, so we keep its params struct on the stack. It
+// only takes a string, this leaves plenty of room for any locals - if it's somehow too small, the
+// call falls back to allocating one as usual.
+const constexpr size_t CONSOLE_OUTPUT_TEXT_PARAMS_SIZE = 0x40;
 
 bool say_bypass_hook(const hook_manager::Details& hook) {
     static const auto console_command_func =
@@ -203,7 +207,8 @@ void BL1Hook::uconsole_output_text(const std::wstring& str) const {
     if (console_output_text.func == nullptr) {
         return;
     }
-    console_output_text.call<void, UStrProperty>(str);
+    func_params::ParamsStorage<CONSOLE_OUTPUT_TEXT_PARAMS_SIZE> storage{};
+    console_output_text.call<void, UStrProperty>(storage, str);
 }
 
 bool BL1Hook::is_console_ready(void) const {
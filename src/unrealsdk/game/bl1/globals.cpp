@@ -24,6 +24,7 @@ const constinit Pattern<18> GOBJECTS_SIG{
     "21 58 ??"          // and [eax+08], ebx
     "89 50 ??"          // mov [eax+0C], edx
 };
+const PatternRegistration GOBJECTS_SIG_REGISTRATION{"GOBJECTS_SIG", GOBJECTS_SIG};
 
 }  // namespace
 
@@ -50,6 +51,7 @@ const constinit Pattern<21> GNAMES_SIG{
     "E8 ????????"    // call 005C21F0
     "5E"             // pop esi
 };
+const PatternRegistration GNAMES_SIG_REGISTRATION{"GNAMES_SIG", GNAMES_SIG};
 
 }  // namespace
 
@@ -23,6 +23,7 @@ const constinit Pattern<32> SET_COMMAND_SIG{
     "74 ??"           // je 0087EC80
     "39 9E ????????"  // cmp [esi+000003E0], ebx
 };
+const PatternRegistration SET_COMMAND_SIG_REGISTRATION{"SET_COMMAND_SIG", SET_COMMAND_SIG};
 
 const constinit Pattern<32> ARRAY_LIMIT_SIG{
     "6A 64"            // push 64
@@ -36,6 +37,7 @@ const constinit Pattern<32> ARRAY_LIMIT_SIG{
     "83 FF 64"         // cmp edi, 64
     "{???? ????????}"  // jl DONT_PRINT_MSG     <---
 };
+const PatternRegistration ARRAY_LIMIT_SIG_REGISTRATION{"ARRAY_LIMIT_SIG", ARRAY_LIMIT_SIG};
 const constexpr auto ARRAY_LIMIT_MESSAGE_OFFSET_FROM_MIN = 5 + 3 + 2 + 6 + 3 + 3;
 const constexpr auto ARRAY_LIMIT_UNLOCK_SIZE = ARRAY_LIMIT_MESSAGE_OFFSET_FROM_MIN + 2;
 
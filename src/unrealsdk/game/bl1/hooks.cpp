@@ -38,12 +38,15 @@ const constinit Pattern<30> PROCESS_EVENT_SIG{
     "33 C5"           // xor eax, ebp
     "89 45 ??"        // mov [ebp-10], eax
 };
+const PatternRegistration PROCESS_EVENT_SIG_REGISTRATION{"PROCESS_EVENT_SIG", PROCESS_EVENT_SIG};
 
 void __fastcall process_event_hook(UObject* obj,
                                    void* edx,
                                    UFunction* func,
                                    void* params,
                                    void* null) {
+    // Kept alive until the original function returns, so the call profiler can time it
+    hook_manager::impl::HookList data{};
     try {
         // This arg seems to be in the process of being deprecated, no usage in ghidra, always seems
         // to be null, and it's gone in later ue versions. Gathering some extra info just in case.
@@ -52,19 +55,22 @@ void __fastcall process_event_hook(UObject* obj,
                 func->get_path_name(), obj->get_path_name());
         }
 
-        auto data = hook_manager::impl::preprocess_hook(L"ProcessEvent", func, obj);
+        data = hook_manager::impl::preprocess_hook(L"ProcessEvent", func, obj);
         if (data != nullptr) {
-            // Copy args so that hooks can't modify them, for parity with call function
-            const WrappedStruct args_base{func, params};
-            WrappedStruct args = args_base.copy_params_only();
-            hook_manager::Details hook{.obj = obj,
-                                       .args = &args,
-                                       .ret = {func->find_return_param()},
-                                       .func = {.func = func, .object = obj}};
+            hook_manager::impl::ProcessEventArgs args{.func = func, .params = params};
+            hook_manager::Details hook{
+                .obj = obj,
+                .args = {&hook_manager::impl::ProcessEventArgs::extract, &args},
+                .ret = {func->find_return_param()},
+                .func = {.func = func, .object = obj}};
 
             const bool block_execution = run_hooks_of_type(data, hook_manager::Type::PRE, hook);
 
             if (!block_execution) {
+                // Make sure post hooks see the args from before the function modified them
+                if (has_post_hooks(data)) {
+                    hook.args.get();
+                }
                 process_event_ptr(obj, edx, func, params, null);
             }
 
@@ -141,29 +147,39 @@ const constinit Pattern<31> CALL_FUNCTION_SIG{
     "50"                 // push eax
     "83 EC 40"           // sub esp, 40
 };
+const PatternRegistration CALL_FUNCTION_SIG_REGISTRATION{"CALL_FUNCTION_SIG", CALL_FUNCTION_SIG};
 
 void __fastcall call_function_hook(UObject* obj,
                                    void* edx,
                                    FFrame* stack,
                                    void* result,
                                    UFunction* func) {
+    // Kept alive until the original function returns, so the call profiler can time it
+    hook_manager::impl::HookList data{};
     try {
-        auto data = hook_manager::impl::preprocess_hook(L"CallFunction", func, obj);
+        data = hook_manager::impl::preprocess_hook(L"CallFunction", func, obj);
         if (data != nullptr) {
-            WrappedStruct args{func};
-            auto original_code = stack->extract_current_args(args);
-
-            hook_manager::Details hook{.obj = obj,
-                                       .args = &args,
-                                       .ret = {func->find_return_param()},
-                                       .func = {.func = func, .object = obj}};
+            hook_manager::impl::CallFunctionArgs args{
+                .func = func, .stack = stack, .original_code = stack->Code};
+            hook_manager::Details hook{
+                .obj = obj,
+                .args = {&hook_manager::impl::CallFunctionArgs::extract, &args},
+                .ret = {func->find_return_param()},
+                .func = {.func = func, .object = obj}};
 
             const bool block_execution = run_hooks_of_type(data, hook_manager::Type::PRE, hook);
 
             if (block_execution) {
+                // Need to extract the args to be able to step over them
+                hook.args.get();
                 stack->Code++;
             } else {
-                stack->Code = original_code;
+                // Post hooks can't extract args after the function has run, so need to do it now
+                if (has_post_hooks(data)) {
+                    hook.args.get();
+                }
+                // Always restore, a pre-hook may have thrown part way through extracting
+                stack->Code = args.original_code;
                 call_function_ptr(obj, edx, stack, result, func);
             }
 
@@ -39,6 +39,7 @@ const constinit Pattern<8> GMALLOC_PATTERN{
     "89 0D {????????}"  // mov [01F703F4],ecx { (05AA6980) }
     "8B 11"             // mov edx,[ecx]
 };
+const PatternRegistration GMALLOC_PATTERN_REGISTRATION{"GMALLOC_PATTERN", GMALLOC_PATTERN};
 
 }  // namespace
 
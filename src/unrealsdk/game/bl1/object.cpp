@@ -45,6 +45,8 @@ const constinit Pattern<47> CONSTRUCT_OBJECT_PATTERN{
     "8B 6C 24 ??"     // mov ebp, [esp+54]
     "89 6C 24 ??"     // mov [esp+14], ebp
 };
+const PatternRegistration CONSTRUCT_OBJECT_PATTERN_REGISTRATION{"CONSTRUCT_OBJECT_PATTERN",
+                                                                CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -92,6 +94,8 @@ const constinit Pattern<13> GET_PATH_NAME_PATTERN{
     "74 ??"        // je 005D09D1
     "85 F6"        // test esi, esi
 };
+const PatternRegistration GET_PATH_NAME_PATTERN_REGISTRATION{"GET_PATH_NAME_PATTERN",
+                                                             GET_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -137,6 +141,8 @@ const constinit Pattern<47> STATIC_FIND_OBJECT_PATTERN{
     "8B 74 24 ??"     // mov esi, [esp+4C]
     "8B 7C 24 ??"     // mov edi, [esp+50]
 };
+const PatternRegistration STATIC_FIND_OBJECT_PATTERN_REGISTRATION{"STATIC_FIND_OBJECT_PATTERN",
+                                                                  STATIC_FIND_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -168,6 +174,8 @@ const constinit Pattern<21> LOAD_PACKAGE_PATTERN{
     "83 EC 28"        // sub esp, 28
     "53"              // push ebx
 };
+const PatternRegistration LOAD_PACKAGE_PATTERN_REGISTRATION{"LOAD_PACKAGE_PATTERN",
+                                                            LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
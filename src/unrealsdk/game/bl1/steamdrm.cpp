@@ -45,14 +45,14 @@ void GetStartupInfoA_hook(LPSTARTUPINFOA lpStartupInfo) {
 
 }  // namespace
 
-void BL1Hook::wait_for_steam_drm(void) {
+bool BL1Hook::wait_for_steam_drm(void) {
     {
         // Immediately suspend the other threads
         const ThreadSuspender suspend{};
 
         if (UNPACKED_ENTRY_SIG.sigscan_nullable() != 0) {
             // If we found a match, we're already unpacked
-            return;
+            return true;
         }
 
         LOG(MISC, "Waiting for steam drm unpack");
@@ -70,7 +70,7 @@ void BL1Hook::wait_for_steam_drm(void) {
 
             LOG(ERROR, "Falling back to a static delay");
             std::this_thread::sleep_for(FALLBACK_DELAY);
-            return;
+            return false;
         }
 
         status = MH_EnableHook(reinterpret_cast<LPVOID>(&GetStartupInfoA));
@@ -80,7 +80,7 @@ void BL1Hook::wait_for_steam_drm(void) {
 
             LOG(ERROR, "Falling back to a static delay");
             std::this_thread::sleep_for(FALLBACK_DELAY);
-            return;
+            return false;
         }
 
         // Drop out of this scope and unsuspend the other threads, let the unpacker run
@@ -89,20 +89,22 @@ void BL1Hook::wait_for_steam_drm(void) {
     std::unique_lock lock(ready_mutex);
     ready_cv.wait(lock, [] { return ready.load(); });
 
+    // We've now seen the unpacked entry point run, failing to clean up the hook doesn't change that
+
     MH_STATUS status = MH_OK;
     status = MH_DisableHook(reinterpret_cast<LPVOID>(&GetStartupInfoA));
     if (status != MH_OK) {
         LOG(ERROR, "Failed to disable GetStartupInfoA hook: {:x}", static_cast<uint32_t>(status));
 
         // If it fails, there isn't really any harm in leaving it active, just return
-        return;
+        return true;
     }
 
     status = MH_RemoveHook(reinterpret_cast<LPVOID>(&GetStartupInfoA));
     if (status != MH_OK) {
         LOG(ERROR, "Failed to remove GetStartupInfoA hook: {:x}", static_cast<uint32_t>(status));
-        return;
     }
+    return true;
 }
 
 }  // namespace unrealsdk::game
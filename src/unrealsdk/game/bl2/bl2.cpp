@@ -20,6 +20,9 @@ void BL2Hook::hook(void) {
     // Make sure to do antidebug asap
     hook_antidebug();
 
+    // Find all our sigscans in one go, the individual functions just pick up the cached results
+    prescan();
+
     hook_process_event();
     hook_call_function();
 
@@ -36,6 +39,8 @@ void BL2Hook::hook(void) {
     hexedit_set_command();
     hexedit_array_limit();
     hexedit_array_limit_message();
+
+    clear_prescan();
 }
 
 void BL2Hook::post_init(void) {
@@ -60,6 +65,7 @@ const constinit Pattern<23> FNAME_INIT_SIG{
     "50"              // push eax
     "81 EC 9C0C0000"  // sub esp, 00000C9C
 };
+const PatternRegistration FNAME_INIT_SIG_REGISTRATION{"FNAME_INIT_SIG", FNAME_INIT_SIG};
 
 }
 
@@ -92,6 +98,7 @@ const constinit Pattern<9> FFRAME_STEP_SIG{
     "8B 41 ??"  // mov eax, [ecx+18]
     "0FB6 10"   // movzx edx, byte ptr [eax]
 };
+const PatternRegistration FFRAME_STEP_SIG_REGISTRATION{"FFRAME_STEP_SIG", FFRAME_STEP_SIG};
 
 }  // namespace
 
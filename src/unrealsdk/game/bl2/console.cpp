@@ -60,6 +60,10 @@ const std::wstring INJECT_CONSOLE_ID = L"unrealsdk_bl2_inject_console";
 // Would prefer to call a native function where possible, however best I can tell, OutputText is
 // actually implemented directly in unrealscript (along most of the console mechanics).
 BoundFunction console_output_text{};
+// Output text gets called for every console line, so we keep its params struct on the stack. It
+// only takes a string, this leaves plenty of room for any locals - if it's somehow too small, the
+// call falls back to allocating one as usual.
+const constexpr size_t CONSOLE_OUTPUT_TEXT_PARAMS_SIZE = 0x40;
 
 bool say_bypass_hook(hook_manager::Details& hook) {
     /*
@@ -304,7 +308,8 @@ void BL2Hook::uconsole_output_text(const std::wstring& str) const {
         return;
     }
 
-    console_output_text.call<void, UStrProperty>(str);
+    func_params::ParamsStorage<CONSOLE_OUTPUT_TEXT_PARAMS_SIZE> storage{};
+    console_output_text.call<void, UStrProperty>(storage, str);
 }
 
 bool BL2Hook::is_console_ready(void) const {
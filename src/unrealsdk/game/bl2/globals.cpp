@@ -22,6 +22,7 @@ const constinit Pattern<17> GOBJECTS_SIG{
     "8B 40 ??"          // mov eax, [eax+08]
     "25 00020000"       // and eax, 00000200
 };
+const PatternRegistration GOBJECTS_SIG_REGISTRATION{"GOBJECTS_SIG", GOBJECTS_SIG};
 
 }  // namespace
 
@@ -45,6 +46,7 @@ const constinit Pattern<10> GNAMES_SIG{
     "8B 45 ??"       // mov eax, [ebp+10]
     "89 03"          // mov [ebx], eax
 };
+const PatternRegistration GNAMES_SIG_REGISTRATION{"GNAMES_SIG", GNAMES_SIG};
 
 }  // namespace
 
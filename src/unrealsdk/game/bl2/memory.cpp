@@ -39,6 +39,7 @@ const constinit Pattern<8> GMALLOC_PATTERN{
     "89 35 {????????}"  // mov [Borderlands2.GDebugger+A95C], esi
     "FF D7"             // call edi
 };
+const PatternRegistration GMALLOC_PATTERN_REGISTRATION{"GMALLOC_PATTERN", GMALLOC_PATTERN};
 
 }  // namespace
 
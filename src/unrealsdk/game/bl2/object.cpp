@@ -52,6 +52,8 @@ const constinit Pattern<49> CONSTRUCT_OBJECT_PATTERN{
     "8B 7D ??"        // mov edi, [ebp+08]
     "8A 87 ????????"  // mov al, [edi+000001CC]
 };
+const PatternRegistration CONSTRUCT_OBJECT_PATTERN_REGISTRATION{"CONSTRUCT_OBJECT_PATTERN",
+                                                                CONSTRUCT_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -106,6 +108,8 @@ const constinit Pattern<15> GET_PATH_NAME_PATTERN{
     "74 ??"     // je Borderlands2.exe+ADB04
     "85 F6"     // test esi, esi
 };
+const PatternRegistration GET_PATH_NAME_PATTERN_REGISTRATION{"GET_PATH_NAME_PATTERN",
+                                                             GET_PATH_NAME_PATTERN};
 
 }  // namespace
 
@@ -156,6 +160,8 @@ const constinit Pattern<56> STATIC_FIND_OBJECT_PATTERN{
     "75 ??"              // jne Borderlands2.GetOutermost+429A
     "83 3D ???????? 00"  // cmp dword ptr [Borderlands2.exe+15E801C], 00
 };
+const PatternRegistration STATIC_FIND_OBJECT_PATTERN_REGISTRATION{"STATIC_FIND_OBJECT_PATTERN",
+                                                                  STATIC_FIND_OBJECT_PATTERN};
 
 }  // namespace
 
@@ -196,6 +202,8 @@ const constinit Pattern<46> LOAD_PACKAGE_PATTERN{
     "64 A3 ????????"  // mov fs:[00000000], eax
     "89 65 ??"        // mov [ebp-10], esp
 };
+const PatternRegistration LOAD_PACKAGE_PATTERN_REGISTRATION{"LOAD_PACKAGE_PATTERN",
+                                                            LOAD_PACKAGE_PATTERN};
 
 }  // namespace
 
@@ -15,6 +15,9 @@ using namespace unrealsdk::memory;
 namespace unrealsdk::game {
 
 void BL3Hook::hook(void) {
+    // Find all our sigscans in one go, the individual functions just pick up the cached results
+    prescan();
+
     hook_process_event();
     hook_call_function();
 
@@ -29,6 +32,8 @@ void BL3Hook::hook(void) {
     find_ftext_as_culture_invariant();
     find_load_package();
     find_persistent_obj_ptrs();
+
+    clear_prescan();
 }
 
 void BL3Hook::post_init(void) {
@@ -54,6 +59,7 @@ const constinit Pattern<15> FNAME_INIT_PATTERN{
     "57"                 // push rdi
     "48 81 EC 60080000"  // sub rsp, 00000860
 };
+const PatternRegistration FNAME_INIT_PATTERN_REGISTRATION{"FNAME_INIT_PATTERN", FNAME_INIT_PATTERN};
 
 }  // namespace
 
@@ -80,6 +86,7 @@ const constinit Pattern<10> FFRAME_STEP_SIG{
     "4C 8B D2"     // mov r10, rdx
     "48 8B D1"     // mov rdx, rcx
 };
+const PatternRegistration FFRAME_STEP_SIG_REGISTRATION{"FFRAME_STEP_SIG", FFRAME_STEP_SIG};
 
 }  // namespace
 
@@ -141,6 +148,8 @@ const constinit Pattern<131> FTEXT_AS_CULTURE_INVARIANT_PATTERN{
     "5F"              // pop rdi
     "C3"              // ret
 };
+const PatternRegistration FTEXT_AS_CULTURE_INVARIANT_PATTERN_REGISTRATION{
+    "FTEXT_AS_CULTURE_INVARIANT_PATTERN", FTEXT_AS_CULTURE_INVARIANT_PATTERN};
 
 }  // namespace
 
@@ -22,6 +22,7 @@ const constinit Pattern<26> GOBJECTS_SIG{
     "E8 ????????"          // call Borderlands3.exe+17854D0
     "C6 05 ???????? 01"    // mov byte ptr [Borderlands3.exe+64B78E0], 01
 };
+const PatternRegistration GOBJECTS_SIG_REGISTRATION{"GOBJECTS_SIG", GOBJECTS_SIG};
 
 }  // namespace
 
@@ -49,6 +50,7 @@ const constinit Pattern<27> GNAMES_SIG{
     "C3"                   // ret
     "33 DB"                // xor ebx, ebx
 };
+const PatternRegistration GNAMES_SIG_REGISTRATION{"GNAMES_SIG", GNAMES_SIG};
 
 }  // namespace
 
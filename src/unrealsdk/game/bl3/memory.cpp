@@ -29,6 +29,7 @@ const constinit Pattern<25> MALLOC_PATTERN{
     "48 8B 0D ????????"  // mov rcx, [Borderlands3.exe+68C4E08]
     "48 85 C9"           // test rcx, rcx
 };
+const PatternRegistration MALLOC_PATTERN_REGISTRATION{"MALLOC_PATTERN", MALLOC_PATTERN};
 
 const constinit Pattern<31> REALLOC_PATTERN{
     "48 89 5C 24 ??"     // mov [rsp+08], rbx
@@ -40,6 +41,7 @@ const constinit Pattern<31> REALLOC_PATTERN{
     "48 8B 0D ????????"  // mov rcx, [Borderlands3.exe+68C4E08]
     "48 8B FA"           // mov rdi, rdx
 };
+const PatternRegistration REALLOC_PATTERN_REGISTRATION{"REALLOC_PATTERN", REALLOC_PATTERN};
 
 const constinit Pattern<20> FREE_PATTERN{
     "48 85 C9"           // test rcx, rcx
@@ -49,6 +51,7 @@ const constinit Pattern<20> FREE_PATTERN{
     "48 8B D9"           // mov rbx, rcx
     "48 8B 0D ????????"  // mov rcx, [Borderlands3.exe+68C4E08]
 };
+const PatternRegistration FREE_PATTERN_REGISTRATION{"FREE_PATTERN", FREE_PATTERN};
 
 }  // namespace
 
@@ -16,6 +16,8 @@ const constinit Pattern<11> ARRAY_LIMIT_MESSAGE{
     "8B 8D ????????"  // mov ecx, [ebp-0000116C]
     "83 C0 9D"        // add eax, -63
 };
+const PatternRegistration ARRAY_LIMIT_MESSAGE_REGISTRATION{"ARRAY_LIMIT_MESSAGE",
+                                                           ARRAY_LIMIT_MESSAGE};
 
 }  // namespace
 
@@ -1,7 +1,11 @@
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/call_log_format.h"
+#include "unrealsdk/call_profiler.h"
+#include "unrealsdk/commands.h"
 #include "unrealsdk/config.h"
 #include "unrealsdk/hook_manager.h"
+#include "unrealsdk/unreal/classes/uclass.h"
 #include "unrealsdk/unreal/classes/ufunction.h"
 #include "unrealsdk/unreal/classes/uobject.h"
 #include "unrealsdk/unreal/structs/fframe.h"
@@ -21,137 +25,707 @@ using DLLSafeCallback = utils::DLLSafeCallback<Callback>;
 namespace impl {
 
 /*
-The fact that hooks run arbitrary user provided callbacks means our data structure can get modified
-in a number of awkward ways while we're in the middle of iterating over it. There's the obvious case
-of a hook can remove itself, but also tricker ones like a hook can invoke a nested hook on itself,
-and only remove itself there, or the upper layer hook could remove itself and the nested one could
-re-add it, etc. It gets even messier if we consider threading.
-
-So the number one concern behind this design is robustness - we need to support essentially
-arbitrary modification while we're in the middle of iterating through it. This means performance is
-a secondary concern - though I still tried keeping it mind - I haven't done any benchmarking.
-
-The easiest way to keep our iterators valid is to use linked lists. However, using a bunch of
-`std::list`s isn't the best for performance, as we'll discuss in a bit, since need several layers
-of them, so instead we use a bunch of intrusive linked lists on our own type.
-
-
-The most basic form of the data structure we want is essentially a:
-    map<FName, map<full_name, map<Type, collection<pair<identifier, callback>>>>>
+Hooks are read on every single unreal function call, potentially from multiple threads at once (e.g.
+both the game and render threads), while they're only modified comparatively rarely. On top of this,
+the fact that hooks run arbitrary user provided callbacks means the hooks can get modified in a
+number of awkward ways while we're in the middle of iterating over them. There's the obvious case of
+a hook can remove itself, but also tricker ones like a hook can invoke a nested hook on itself, and
+only remove itself there, or the upper layer hook could remove itself and the nested one could
+re-add it, etc.
+
+To deal with both of these, the hooks which are actually read are stored in a table which is
+immutable once published. Readers grab the current table, and can then iterate through it at their
+leisure - nothing can change underneath them. Writers take a lock, modify a separate canonical list
+of all hooks, then compile it into a new table and atomically swap it in. Rebuilding the whole table
+is relatively expensive, but it only holds a few hundred hooks at most, and the individual hook
+entries are shared between versions.
+
+The tricky part is working out when it's safe to free an old table. Refcounting it would mean every
+call on every thread touches the same cache line, so instead we use epoch based reclamation. Every
+thread which reads hooks has a record of the global epoch at the time it started reading, or 0 if
+it's not currently reading. When a writer retires a table, it tags it with the current epoch, then
+advances the global one. Any reader which starts after this point can only possibly see the new
+table. Once all active readers are on a later epoch than a retired table, nothing can be using it
+anymore, and it can be freed. All of this is handled by writers, readers never wait on anything.
+
+A read section spans all the way from preprocessing a call through to running it's post hooks, so
+that the hook list we give out stays valid for the entire call. Read sections may nest, e.g. when a
+hook calls another hooked function.
+
+Note that a consequence of this is that modifications are only picked up by the next call - if a
+hook removes another hook on the same function, it will still run this time round.
+
+
+Since the table is never modified after it's compiled, we're free to lay it out however is fastest to
+read. The most basic form of the data we need is essentially a:
+    map<FName, map<full_name, map<Type, list<callback>>>>
 
 Matching FNames first lets us discard function calls far quicker than needing to do a string
-comparison on the full name. After matching both of them, we then need to split by hook type, which
-finally gets us the collection of callbacks to run. The identifiers have no influence when matching
-hooks, they're only used when adding/removing them.
-
-The smallest unit we have to iterate over is the hooks of the same type on the same function - the
-one labeled just "collection" above. This is the `next_in_collection` linked list.
-
-Then we need to be able to jump between the collections on the same hook, but of different type. The
-heads of the collection linked lists form into a second `next_type` linked list. We use an intrusive
-linked list, so the exact same node from the above list also holds the pointers for this one.
-
-Above that, we need to jump between groups of hooks which share the same fname, but have different
-full function names. The heads of the type linked lists form the third `next_function` linked list.
-
-Finally, we need to iterate through FNames. We actually do this using a hash table - but we still
-need to deal with collisions. The heads of the function linked lists form our fourth and final
-`next_collision` linked list.
-
-Trying to roughly diagram an example, this is what might be in a single hash bucket:
-
-Collision  | [A] -----------------------------> [F]
-           |  :                                  :
-Function   | [A] ---------------> [D]           [F] -> [G]
-           |  :                    :             :      :
-Type       | [A] --------> [C]     :             :      :
-           |  :             :      :             :      :
-Collection | [A] -> [B]    [C]    [D] -> [E]    [F]    [G]
-
-[A] Class::Func, post-hook
-[B] Class::Func, post-hook
-[C] Class::Func, pre-hook
-[D] OtherClass::Func
-[E] OtherClass::Func
-[F] ThirdClass::SomeOtherFunc, where `SomeOtherFunc` and `Func` happen to get a hash collision
-[G] FourthClass::SomeOtherFunc
-
-Each column is a single node, a node may be in multiple linked lists.
+comparison on the full name, so the top level is an open addressed hash table, indexed by FName.
+Each slot points to a contiguous run of functions sharing that FName - usually just one. Each
+function then points to a contiguous run of callbacks, sorted by hook type, so that running all hooks
+of a given type is just a linear scan, and checking if there are any is just comparing two offsets.
+
+Index    | [Func]            [SomeOtherFunc]
+         |   :                  :
+Function | [Class::Func] [OtherClass::Func] [ThirdClass::SomeOtherFunc]
+         |   :              :                  :
+Entries  | [A] [B] [C]     [D] [E]            [F]
+         |  pre  post       pre pre            post
 */
 
-struct Node {
-   public:
-    FName fname;
-    std::wstring full_name;
-    Type type;
+struct HookEntry {
     std::wstring identifier;
+    int32_t priority;
+    // If not null, the hook only runs on calls on this object
+    const UObject* obj_filter;
+    // If not null, the hook only runs on calls on instances of this class
+    const UClass* cls_filter;
     DLLSafeCallback callback;
 
-    // Using shared pointers because it's easy
-    // Since we use std::make_shared, we're not really wasting allocations, but as a future
-    // optimization we could use an intrusive reference count to avoid repeating all the control
-    // block pointers, and save a little memory.
-    std::shared_ptr<Node> next_collision = nullptr;
-    std::shared_ptr<Node> next_function = nullptr;
-    std::shared_ptr<Node> next_type = nullptr;
-    std::shared_ptr<Node> next_in_collection = nullptr;
-
-    Node(FName fname,
-         std::wstring_view full_name,
-         Type type,
-         std::wstring_view identifier,
-         DLLSafeCallback&& callback)
-        : fname(fname),
-          full_name(full_name),
-          type(type),
-          identifier(identifier),
+    // Timing stats, only updated while hook timing is enabled - except for exceptions, which are
+    // always counted, since they're already on the slow path
+    std::atomic<uint64_t> calls = 0;
+    std::atomic<uint64_t> exceptions = 0;
+    std::atomic<uint64_t> total_ns = 0;
+    std::atomic<uint64_t> max_ns = 0;
+
+    HookEntry(std::wstring_view identifier,
+              int32_t priority,
+              const UObject* obj_filter,
+              const UClass* cls_filter,
+              DLLSafeCallback&& callback)
+        : identifier(identifier),
+          priority(priority),
+          obj_filter(obj_filter),
+          cls_filter(cls_filter),
           callback(std::move(callback)) {}
+
+    /**
+     * @brief Checks if this hook should run on a call on the given object.
+     *
+     * @param obj The object the function was called on.
+     * @return True if the hook should run.
+     */
+    [[nodiscard]] bool matches(const UObject* obj) const {
+        if (this->obj_filter != nullptr && this->obj_filter != obj) {
+            return false;
+        }
+        if (this->cls_filter != nullptr && (obj == nullptr || !obj->is_instance(this->cls_filter))) {
+            return false;
+        }
+        return true;
+    }
+};
+
+const constexpr auto HOOK_TYPE_COUNT = 3;
+
+struct FunctionHooks {
+    std::wstring full_name;
+    // All hooks on this function, a view into the table's entries
+    std::span<HookEntry* const> entries;
+    // The hooks of type `n` are in the range [type_offsets[n], type_offsets[n + 1]) of the above
+    std::array<uint32_t, HOOK_TYPE_COUNT + 1> type_offsets;
+    // True if any hook on this function runs regardless of object, so we can skip checking filters
+    bool any_unfiltered;
 };
 
 namespace {
 
-const constexpr auto HASH_TABLE_SIZE = 0x1000;
-std::array<std::shared_ptr<Node>, HASH_TABLE_SIZE> hooks_hash_table;
+struct IndexSlot {
+    FName fname;
+    // The functions in this slot are in the functions range [first_function, end_function). If
+    // these are equal, the slot is empty.
+    uint32_t first_function = 0;
+    uint32_t end_function = 0;
+};
+
+struct HookTable {
+    // Unique for every published table, used to detect when caches need to be invalidated
+    uint64_t generation = 0;
+
+    // Always a power of two in size
+    std::vector<IndexSlot> index;
+    std::vector<FunctionHooks> functions;
+    std::vector<HookEntry*> entries;
+
+    // Keeps all the entries we point to alive. Only touched by writers.
+    std::vector<std::shared_ptr<HookEntry>> owned_entries;
+};
+
+/**
+ * @brief Gets the index of the hooks of the given type within a function.
+ *
+ * @param type The hook type.
+ * @return The index into `FunctionHooks::type_offsets`, or `RegisteredFunction::hooks`.
+ */
+size_t get_type_index(Type type) {
+    auto idx = static_cast<size_t>(type);
+    if (idx >= HOOK_TYPE_COUNT) {
+        throw std::out_of_range("Invalid hook type");
+    }
+    return idx;
+}
+
+#pragma region Reclamation
+
+std::atomic<HookTable*> current_table = nullptr;
+std::atomic<uint64_t> global_epoch = 1;
+
+struct ReaderRecord {
+    // The global epoch when this thread started reading, or 0 if it's not currently reading
+    std::atomic<uint64_t> epoch = 0;
+    // How many nested read sections this thread is currently in - only accessed by it's own thread
+    size_t depth = 0;
+
+    ReaderRecord(void);
+    ~ReaderRecord();
+
+    ReaderRecord(const ReaderRecord&) = delete;
+    ReaderRecord(ReaderRecord&&) = delete;
+    ReaderRecord& operator=(const ReaderRecord&) = delete;
+    ReaderRecord& operator=(ReaderRecord&&) = delete;
+};
+
+std::mutex reader_records_mutex{};
+std::vector<ReaderRecord*> reader_records{};
+
+ReaderRecord::ReaderRecord(void) {
+    const std::lock_guard<std::mutex> lock(reader_records_mutex);
+    reader_records.push_back(this);
+}
+
+ReaderRecord::~ReaderRecord() {
+    const std::lock_guard<std::mutex> lock(reader_records_mutex);
+    std::erase(reader_records, this);
+}
+
+thread_local ReaderRecord this_thread_reader{};
+
+/**
+ * @brief Enters a read section, during which the returned table is guaranteed to stay alive.
+ *
+ * @param section Output guard over the read section. The table must not be used after it's exited.
+ * @return The current hook table. May be null if no hooks have ever been added.
+ */
+const HookTable* begin_read(ReadSection& section) {
+    // Create the guard before doing anything else, so nothing can leave the section open
+    section = ReadSection::enter();
+    return current_table.load();
+}
+
+// Writer state, all guarded by the mutex
+std::mutex hooks_mutex{};
+std::vector<std::pair<HookTable*, uint64_t>> retired_tables{};
 
 /**
- * @brief Hashes the given fname, and returns which index of the table it goes in.
+ * @brief Publishes a new hook table, and retires the old one.
+ * @note Must be called while holding the hooks mutex.
  *
- * @param name The name to check.
+ * @param table The new table.
+ */
+void publish_table(std::unique_ptr<HookTable>&& table) {
+    auto old_table = current_table.exchange(table.release());
+    if (old_table != nullptr) {
+        retired_tables.emplace_back(old_table, global_epoch.fetch_add(1));
+    }
+}
+
+/**
+ * @brief Collects all retired tables which can no longer be accessed by any reader.
+ * @note Must be called while holding the hooks mutex.
+ * @note Freeing tables may end up freeing hook callbacks, which may run arbitrary code. The returned
+ *       tables should be destroyed after releasing the lock.
+ *
+ * @return A list of the tables which are safe to free.
+ */
+std::vector<std::unique_ptr<HookTable>> collect_unused_tables(void) {
+    std::vector<std::unique_ptr<HookTable>> unused{};
+    if (retired_tables.empty()) {
+        return unused;
+    }
+
+    auto min_active_epoch = std::numeric_limits<uint64_t>::max();
+    {
+        const std::lock_guard<std::mutex> lock(reader_records_mutex);
+        for (const auto& reader : reader_records) {
+            auto epoch = reader->epoch.load();
+            if (epoch != 0) {
+                min_active_epoch = std::min(min_active_epoch, epoch);
+            }
+        }
+    }
+
+    std::erase_if(retired_tables, [&unused, min_active_epoch](auto& retired) {
+        if (retired.second < min_active_epoch) {
+            unused.emplace_back(retired.first);
+            return true;
+        }
+        return false;
+    });
+    return unused;
+}
+
+}  // namespace
+
+ReadSection::~ReadSection() {
+    this->exit();
+}
+
+ReadSection::ReadSection(ReadSection&& other) noexcept
+    : active(std::exchange(other.active, false)) {}
+
+ReadSection& ReadSection::operator=(ReadSection&& other) noexcept {
+    std::swap(this->active, other.active);
+    return *this;
+}
+
+ReadSection ReadSection::enter(void) {
+    auto& reader = this_thread_reader;
+    if (reader.depth++ == 0) {
+        // Both of these must be sequentially consistent, writers rely on us publishing our epoch
+        // before we read the table pointer.
+        reader.epoch.store(global_epoch.load());
+    }
+
+    ReadSection section{};
+    section.active = true;
+    return section;
+}
+
+void ReadSection::exit(void) {
+    if (!std::exchange(this->active, false)) {
+        return;
+    }
+
+    auto& reader = this_thread_reader;
+    if (--reader.depth == 0) {
+        reader.epoch.store(0, std::memory_order_release);
+    }
+}
+
+namespace {
+
+#pragma endregion
+
+/**
+ * @brief Gets the hash table index an fname should start probing from.
+ *
+ * @param fname The fname to look up.
+ * @param index_size The size of the hash table. Must be a power of two.
  * @return The hash table index.
  */
-size_t get_table_index(FName fname) {
+size_t get_table_index(FName fname, size_t index_size) {
     static_assert(sizeof(unrealsdk::unreal::FName) == sizeof(uint64_t),
                   "FName is not same size as a uint64");
     uint64_t val{};
     memcpy(&val, &fname, sizeof(fname));
 
-    // Identity seems mostly good enough - FNames already are just a relatively small integer value.
-    // This throws away the number field, but that's very rarely used on functions to begin with.
-    return val % HASH_TABLE_SIZE;
+    // FNames are already relatively small integers, but tend to be clustered. Fibonacci hashing
+    // spreads them out for very little cost.
+    const constexpr uint64_t fibonacci_multiplier = 0x9E3779B97F4A7C15;
+    return static_cast<size_t>((val * fibonacci_multiplier) >> 32) & (index_size - 1);
+}
+
+/**
+ * @brief Finds all functions in a table which share an fname.
+ *
+ * @param table The table to search through.
+ * @param fname The fname to search for.
+ * @return A span of all the matching functions. Empty if there are none.
+ */
+std::span<const FunctionHooks> find_functions(const HookTable& table, FName fname) {
+    const auto index_size = table.index.size();
+    for (auto idx = get_table_index(fname, index_size);; idx = (idx + 1) & (index_size - 1)) {
+        const auto& slot = table.index[idx];
+        if (slot.first_function == slot.end_function) {
+            return {};
+        }
+        if (slot.fname == fname) {
+            return std::span{table.functions}.subspan(slot.first_function,
+                                                      slot.end_function - slot.first_function);
+        }
+    }
+}
+
+// Writer state, all guarded by the hooks mutex
+struct RegisteredFunction {
+    std::wstring full_name;
+    // Each list is kept sorted by descending priority, in insertion order within the same priority,
+    // so that compiling the table can just copy them straight across.
+    std::array<std::vector<std::shared_ptr<HookEntry>>, HOOK_TYPE_COUNT> hooks;
+};
+std::unordered_map<FName, std::vector<RegisteredFunction>> registered_hooks{};
+uint64_t table_generation = 0;
+
+/**
+ * @brief Compiles the currently registered hooks into a new hook table.
+ * @note Must be called while holding the hooks mutex.
+ *
+ * @return The new table.
+ */
+std::unique_ptr<HookTable> compile_table(void) {
+    auto table = std::make_unique<HookTable>();
+    table->generation = ++table_generation;
+
+    // Keep the load factor at or below 50%, so that probe sequences stay short
+    size_t index_size = 16;
+    while (index_size < registered_hooks.size() * 2) {
+        index_size *= 2;
+    }
+    table->index.resize(index_size);
+
+    for (const auto& [fname, functions] : registered_hooks) {
+        auto idx = get_table_index(fname, index_size);
+        while (table->index[idx].first_function != table->index[idx].end_function) {
+            idx = (idx + 1) & (index_size - 1);
+        }
+
+        auto& slot = table->index[idx];
+        slot.fname = fname;
+        slot.first_function = static_cast<uint32_t>(table->functions.size());
+
+        for (const auto& function : functions) {
+            auto& compiled = table->functions.emplace_back();
+            compiled.full_name = function.full_name;
+            compiled.any_unfiltered = false;
+
+            // Can't point at the entries array yet since it may still move, just track offsets
+            uint32_t relative_offset = 0;
+            for (size_t type_idx = 0; type_idx < HOOK_TYPE_COUNT; type_idx++) {
+                compiled.type_offsets.at(type_idx) = relative_offset;
+                for (const auto& entry : function.hooks.at(type_idx)) {
+                    table->entries.push_back(entry.get());
+                    table->owned_entries.push_back(entry);
+                    relative_offset++;
+
+                    if (entry->obj_filter == nullptr && entry->cls_filter == nullptr) {
+                        compiled.any_unfiltered = true;
+                    }
+                }
+            }
+            compiled.type_offsets.at(HOOK_TYPE_COUNT) = relative_offset;
+        }
+
+        slot.end_function = static_cast<uint32_t>(table->functions.size());
+    }
+
+    size_t entries_offset = 0;
+    for (auto& function : table->functions) {
+        auto size = function.type_offsets.at(HOOK_TYPE_COUNT);
+        function.entries = std::span{table->entries}.subspan(entries_offset, size);
+        entries_offset += size;
+    }
+
+    return table;
 }
 
+/**
+ * @brief Finds a registered function.
+ * @note Must be called while holding the hooks mutex.
+ *
+ * @param fname The function's FName.
+ * @param full_name The function's full path name.
+ * @return A pointer to the function's hooks, or nullptr if it has none.
+ */
+RegisteredFunction* find_registered_function(FName fname, std::wstring_view full_name) {
+    auto functions = registered_hooks.find(fname);
+    if (functions == registered_hooks.end()) {
+        return nullptr;
+    }
+
+    auto function = std::ranges::find_if(
+        functions->second, [full_name](auto& function) { return function.full_name == full_name; });
+    if (function == functions->second.end()) {
+        return nullptr;
+    }
+    return &*function;
+}
+
+/**
+ * @brief Checks if a list of hooks contains the given identifier.
+ *
+ * @param hooks The list of hooks to search through.
+ * @param identifier The identifier to search for.
+ * @return An iterator to the matching hook, or the end iterator if it doesn't exist.
+ */
+auto find_identifier(std::vector<std::shared_ptr<HookEntry>>& hooks, std::wstring_view identifier) {
+    return std::ranges::find_if(
+        hooks, [identifier](auto& entry) { return entry->identifier == identifier; });
+}
+
+/*
+Once a function's fname matches, working out which (if any) of the full names it matches requires
+it's path name - which is a full string build every time. Since there are a lot of commonly called
+functions sharing short names (e.g. `Tick`), this ends up happening on a large fraction of all calls.
+
+To avoid this, we remember which function hooks each function object resolved to. This is stored
+per thread, so that reading it never needs synchronization. Since we store pointers into a specific
+table, we need to throw everything away whenever it gets replaced.
+*/
+
+struct CachedLookup {
+    // Used to detect if the function object got freed, and something else got allocated over it
+    FName fname;
+    const UObject* outer;
+
+    // The function's hooks, or nullptr if it's not hooked
+    const FunctionHooks* hooks;
+};
+
+struct LookupCache {
+    uint64_t generation = 0;
+    std::unordered_map<const UFunction*, CachedLookup> entries;
+};
+
+thread_local LookupCache lookup_cache{};
+
+#pragma region Call Logging
+
+/*
+Calls can be logged in one of two formats, picked using `unrealsdk.log_all_calls_format`.
+
+The default TSV format writes each call's source, function path name, and object path name, on
+their own line. This is easy to read, but needs two path names and a shared file lock on every
+single call, which is very slow.
+
+The binary format is designed to be cheap enough to leave on during real play. Each thread appends
+calls to it's own buffer, which is written to the file in blocks. Rather than writing names, calls
+only store pointers, and the full name of each pointer is written once, the first time a thread
+sees it (or after it gets reused for a different object). See `call_log_format.h` for the full
+format, and `tools/decode_call_log.py` to decode it.
+*/
+
+enum class CallLogFormat : uint8_t {
+    TSV,
+    BINARY,
+};
+
 bool should_log_all_calls = false;
+CallLogFormat log_all_calls_format = CallLogFormat::TSV;
 std::wofstream log_all_calls_stream{};
+std::ofstream log_all_calls_binary_stream{};
 std::mutex log_all_calls_stream_mutex{};
 
+namespace binary_call_log {
+
+// Write out a thread's buffer once it gets this big
+const constexpr size_t FLUSH_SIZE = 0x10000;
+
+// Incremented each time logging is started, so that threads know to discard any old state
+std::atomic<uint32_t> session{0};
+// The steady clock time the current session started, in nanoseconds. Written before the session
+// counter gets incremented, so it's published by the release/acquire pair on that.
+std::atomic<int64_t> session_start_ns{0};
+
+class ThreadBuffer;
+
+std::mutex all_buffers_mutex{};
+std::unordered_set<ThreadBuffer*> all_buffers{};
+
+class ThreadBuffer {
+   private:
+    struct SeenObject {
+        FName name;
+        const UObject* outer;
+        const UClass* cls;
+    };
+
+    // Only ever contended while another thread is flushing all buffers
+    std::mutex mutex;
+
+    uint32_t session = 0;
+    uint32_t thread_id;
+    call_log::Block block;
+
+    std::unordered_set<const wchar_t*> seen_sources;
+    std::unordered_map<const UObject*, SeenObject> seen_objects;
+
+    /**
+     * @brief Writes an object's name, if this thread hasn't already.
+     *
+     * @param obj The object to write the name of.
+     */
+    void ensure_object_named(const UObject* obj) {
+        SeenObject seen{.name = obj->Name(), .outer = obj->Outer(), .cls = obj->Class()};
+
+        auto iter = this->seen_objects.find(obj);
+        if (iter != this->seen_objects.end() && iter->second.name == seen.name
+            && iter->second.outer == seen.outer && iter->second.cls == seen.cls) {
+            return;
+        }
+
+        this->seen_objects.insert_or_assign(obj, seen);
+        this->block.write_name(reinterpret_cast<uintptr_t>(obj), obj->get_path_name());
+    }
+
+    /**
+     * @brief Writes the buffer to the log file, and starts a new block.
+     * @note Assumes the buffer's mutex is already held.
+     */
+    void flush_locked(void) {
+        if (this->block.size() == 0) {
+            return;
+        }
+
+        auto header = this->block.header(this->thread_id);
+        const auto& data = this->block.data();
+
+        {
+            const std::lock_guard<std::mutex> lock(log_all_calls_stream_mutex);
+            // If logging got stopped from under us, this data belongs to an old file, just drop it
+            if (log_all_calls_binary_stream.is_open()
+                && this->session == binary_call_log::session.load(std::memory_order_relaxed)) {
+                // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+                log_all_calls_binary_stream.write(reinterpret_cast<const char*>(header.data()),
+                                                  static_cast<std::streamsize>(header.size()));
+                log_all_calls_binary_stream.write(reinterpret_cast<const char*>(data.data()),
+                                                  static_cast<std::streamsize>(data.size()));
+                // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+            }
+        }
+
+        this->block.reset(0);
+    }
+
+   public:
+    ThreadBuffer(void) : thread_id(GetCurrentThreadId()) {
+        this->block.reserve(FLUSH_SIZE + FLUSH_SIZE / 2);
+
+        const std::lock_guard<std::mutex> lock(all_buffers_mutex);
+        all_buffers.insert(this);
+    }
+
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    ThreadBuffer(ThreadBuffer&&) = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+    ThreadBuffer& operator=(ThreadBuffer&&) = delete;
+
+    ~ThreadBuffer() {
+        const std::lock_guard<std::mutex> all_lock(all_buffers_mutex);
+        all_buffers.erase(this);
+
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->flush_locked();
+    }
+
+    /**
+     * @brief Records a call.
+     *
+     * @param source The source of the call.
+     * @param func The function being called.
+     * @param obj The object it's being called on.
+     */
+    void record(std::wstring_view source, const UFunction* func, const UObject* obj) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+
+        auto current_session = binary_call_log::session.load(std::memory_order_acquire);
+        if (this->session != current_session) {
+            this->session = current_session;
+            this->block.reset(0);
+            this->seen_sources.clear();
+            this->seen_objects.clear();
+        }
+
+        auto steady_now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        auto now = static_cast<uint64_t>(
+            steady_now - binary_call_log::session_start_ns.load(std::memory_order_relaxed));
+        if (this->block.size() == 0) {
+            this->block.reset(now);
+        }
+
+        auto source_ptr = reinterpret_cast<uintptr_t>(source.data());
+        if (this->seen_sources.insert(source.data()).second) {
+            this->block.write_name(source_ptr, source);
+        }
+        this->ensure_object_named(func);
+        this->ensure_object_named(obj);
+
+        this->block.write_call(now, source_ptr, reinterpret_cast<uintptr_t>(func),
+                               reinterpret_cast<uintptr_t>(obj));
+
+        if (this->block.size() >= FLUSH_SIZE) {
+            this->flush_locked();
+        }
+    }
+
+    /**
+     * @brief Writes any buffered calls to the log file.
+     */
+    void flush(void) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->flush_locked();
+    }
+};
+
+thread_local ThreadBuffer thread_buffer{};
+
+/**
+ * @brief Starts a new binary log session, writing the file header.
+ * @note Assumes the stream mutex is already held, and that the stream was just opened.
+ */
+void start_session(void) {
+    std::vector<uint8_t> header{};
+    call_log::write_file_header(header);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    log_all_calls_binary_stream.write(reinterpret_cast<const char*>(header.data()),
+                                      static_cast<std::streamsize>(header.size()));
+
+    session_start_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count(),
+                           std::memory_order_relaxed);
+    session.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Writes the buffered calls from every thread to the log file.
+ */
+void flush_all_threads(void) {
+    const std::lock_guard<std::mutex> lock(all_buffers_mutex);
+    for (auto buffer : all_buffers) {
+        buffer->flush();
+    }
+}
+
+}  // namespace binary_call_log
+
 void log_all_calls(bool should_log) {
     // Only keep this file stream open while we need it
     if (should_log) {
+        auto format_str = config::get_str("unrealsdk.log_all_calls_format").value_or("tsv");
+        auto format = format_str == "binary" ? CallLogFormat::BINARY : CallLogFormat::TSV;
+
+        auto file = config::get_str("unrealsdk.log_all_calls_file")
+                        .value_or(format == CallLogFormat::BINARY ? "unrealsdk.calls.bin"
+                                                                  : "unrealsdk.calls.tsv");
+        auto path = utils::get_this_dll().parent_path() / file;
+
         const std::lock_guard<std::mutex> lock(log_all_calls_stream_mutex);
-        log_all_calls_stream.open(
-            utils::get_this_dll().parent_path()
-                / config::get_str("unrealsdk.log_all_calls_file").value_or("unrealsdk.calls.tsv"),
-            std::wofstream::trunc);
+        if (format == CallLogFormat::BINARY) {
+            log_all_calls_binary_stream.open(path, std::ofstream::trunc | std::ofstream::binary);
+            binary_call_log::start_session();
+        } else {
+            log_all_calls_stream.open(path, std::wofstream::trunc);
+        }
+        log_all_calls_format = format;
     }
 
     should_log_all_calls = should_log;
 
     if (!should_log) {
+        binary_call_log::flush_all_threads();
+
         const std::lock_guard<std::mutex> lock(log_all_calls_stream_mutex);
         log_all_calls_stream.close();
+        log_all_calls_binary_stream.close();
     }
 }
 
+#pragma endregion
+
 thread_local bool should_inject_next_call = false;
 
 void inject_next_call(void) {
@@ -175,260 +749,237 @@ FName extract_func_obj_name(std::wstring_view func) {
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              DLLSafeCallback&& callback) {
+              const UObject* obj_filter,
+              const UClass* cls_filter,
+              DLLSafeCallback&& callback,
+              int32_t priority) {
     auto fname = extract_func_obj_name(func);
+    auto type_idx = get_type_index(type);
 
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't in the hash table, can just add directly.
-        hooks_hash_table.at(hash_idx) =
-            std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-        return true;
-    }
+    // Declared before the lock, so that they're only destroyed after it's released
+    std::vector<std::unique_ptr<HookTable>> unused_tables{};
+    const std::lock_guard<std::mutex> lock(hooks_mutex);
 
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name, so add it to the end
-            node->next_collision =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
-        }
-        node = node->next_collision;
+    auto function = find_registered_function(fname, func);
+    if (function == nullptr) {
+        function = &registered_hooks[fname].emplace_back();
+        function->full_name = func;
     }
 
-    // Look though full function names
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            node->next_function =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
-        }
-        node = node->next_function;
+    auto& hooks = function->hooks.at(type_idx);
+    if (find_identifier(hooks, identifier) != hooks.end()) {
+        return false;
     }
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type yet
-            node->next_type =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-            return true;
-        }
-        node = node->next_type;
-    }
+    // Insert after all hooks of the same or higher priority
+    auto insert_pos = std::ranges::find_if(
+        hooks, [priority](auto& entry) { return entry->priority < priority; });
+    hooks.insert(insert_pos, std::make_shared<HookEntry>(identifier, priority, obj_filter,
+                                                         cls_filter, std::move(callback)));
 
-    // Look through all remaining hooks to see if we can match the identifier
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier, add our new hook at the end
-            node->next_in_collection =
-                std::make_shared<Node>(fname, func, type, identifier, std::move(callback));
-        }
-        node = node->next_in_collection;
-    }
-
-    // We already have this identifier, can't insert
-    return false;
+    publish_table(compile_table());
+    unused_tables = collect_unused_tables();
+    return true;
 }
 
 bool has_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
     auto fname = extract_func_obj_name(func);
+    auto type_idx = get_type_index(type);
 
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
+    const std::lock_guard<std::mutex> lock(hooks_mutex);
+
+    auto function = find_registered_function(fname, func);
+    if (function == nullptr) {
         return false;
     }
 
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
-            return false;
-        }
-        node = node->next_collision;
-    }
+    auto& hooks = function->hooks.at(type_idx);
+    return find_identifier(hooks, identifier) != hooks.end();
+}
 
-    // Look though full function names
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return false;
-        }
-        node = node->next_function;
-    }
+bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
+    auto fname = extract_func_obj_name(func);
+    auto type_idx = get_type_index(type);
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type
-            return false;
-        }
-        node = node->next_type;
+    std::vector<std::unique_ptr<HookTable>> unused_tables{};
+    const std::lock_guard<std::mutex> lock(hooks_mutex);
+
+    auto function = find_registered_function(fname, func);
+    if (function == nullptr) {
+        return false;
     }
 
-    // Look through all remaining hooks to see if we can match the identifier
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier
-            return false;
+    auto& hooks = function->hooks.at(type_idx);
+    auto entry = find_identifier(hooks, identifier);
+    if (entry == hooks.end()) {
+        return false;
+    }
+    hooks.erase(entry);
+
+    // If this was the last hook on the function, remove it entirely, so that calls to it can
+    // early exit again
+    if (std::ranges::all_of(function->hooks, [](auto& hooks) { return hooks.empty(); })) {
+        auto functions = registered_hooks.find(fname);
+        std::erase_if(functions->second, [function](auto& other) { return &other == function; });
+        if (functions->second.empty()) {
+            registered_hooks.erase(functions);
         }
-        node = node->next_in_collection;
     }
 
+    publish_table(compile_table());
+    unused_tables = collect_unused_tables();
     return true;
 }
 
-bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier) {
-    auto fname = extract_func_obj_name(func);
+#pragma region Hook Timing
 
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
-        return false;
-    }
+/*
+When a frame hitches, the first question is usually which hook caused it. Hooks can optionally be
+timed, with stats stored directly on each hook entry. Since entries are shared between tables, and
+only a single entry ever exists for each (function, type, identifier), these are naturally keyed the
+way we want, and get discarded along with the hook.
 
-    // Look through hash collisions
-    decltype(node) prev_collision = nullptr;
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
-            return false;
-        }
-        prev_collision = node;
-        node = node->next_collision;
+When disabled, this costs a single relaxed load per `run_hooks_of_type` call.
+*/
+
+std::atomic<bool> should_time_hooks{false};
+std::atomic<uint64_t> slow_hook_threshold_ns{0};
+// Set if either of the above are, so that running hooks only needs to check one value
+std::atomic<bool> hook_timing_active{false};
+
+/**
+ * @brief Updates if hook timing is active, after changing either of it's settings.
+ */
+void update_hook_timing_active(void) {
+    hook_timing_active = should_time_hooks.load() || slow_hook_threshold_ns.load() != 0;
+}
+
+/**
+ * @brief Gets the name of a hook type.
+ *
+ * @param type The hook type.
+ * @return The type's name.
+ */
+std::wstring_view get_type_name(Type type) {
+    switch (type) {
+        case Type::PRE:
+            return L"pre";
+        case Type::POST:
+            return L"post";
+        case Type::POST_UNCONDITIONAL:
+            return L"post unconditional";
+        default:
+            return L"unknown";
     }
+}
 
-    // Look though full function names
-    decltype(node) prev_function = nullptr;
-    while (node->full_name != func) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return false;
+/**
+ * @brief Records the time a hook took to run.
+ *
+ * @param entry The hook which ran.
+ * @param type The hook's type.
+ * @param hook The details the hook was run with.
+ * @param time How long the hook took.
+ */
+void record_hook_time(HookEntry& entry,
+                      Type type,
+                      const Details& hook,
+                      std::chrono::nanoseconds time) {
+    auto time_ns = static_cast<uint64_t>(time.count());
+
+    if (should_time_hooks.load(std::memory_order_relaxed)) {
+        entry.calls.fetch_add(1, std::memory_order_relaxed);
+        entry.total_ns.fetch_add(time_ns, std::memory_order_relaxed);
+
+        auto max_ns = entry.max_ns.load(std::memory_order_relaxed);
+        while (max_ns < time_ns
+               && !entry.max_ns.compare_exchange_weak(max_ns, time_ns, std::memory_order_relaxed)) {
         }
-        prev_function = node;
-        node = node->next_function;
     }
 
-    // Look through hook types
-    decltype(node) prev_type = nullptr;
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // We found the right function, but it doesn't have any hooks of this type
-            return false;
-        }
-        prev_type = node;
-        node = node->next_type;
+    auto threshold_ns = slow_hook_threshold_ns.load(std::memory_order_relaxed);
+    if (threshold_ns != 0 && time_ns > threshold_ns) {
+        LOG(WARNING, L"Slow {} hook '{}' on {} took {}us", get_type_name(type), entry.identifier,
+            hook.func.func->get_path_name(),
+            std::chrono::duration_cast<std::chrono::microseconds>(time).count());
     }
+}
 
-    // Look through all remaining hooks to see if we can match the identifier
-    decltype(node) prev_in_collection = nullptr;
-    while (node->identifier != identifier) {
-        if (node->next_in_collection == nullptr) {
-            // Didn't find a matching identifier
-            return false;
+/**
+ * @brief Resets the timing stats of all current hooks.
+ */
+void reset_hook_stats(void) {
+    const std::lock_guard<std::mutex> lock(hooks_mutex);
+    for (const auto& [fname, functions] : registered_hooks) {
+        for (const auto& function : functions) {
+            for (const auto& hooks : function.hooks) {
+                for (const auto& entry : hooks) {
+                    entry->calls = 0;
+                    entry->exceptions = 0;
+                    entry->total_ns = 0;
+                    entry->max_ns = 0;
+                }
+            }
         }
-        prev_in_collection = node;
-        node = node->next_in_collection;
     }
+}
 
-    /*
-    We found a matching hook - 'node' is pointing at it.
-
-    Consider the following diagram the diagram from above:
-
-    Collision  | [A] -----------------------------> [F]
-               |  :                                  :
-    Function   | [A] ---------------> [D]           [F]
-               |  :                    :             :
-    Type       | [A]                   :            [F] --------> [H]
-               |  :                    :             :             :
-    Collection | [A] -> [B] -> [C]    [D] -> [E]    [F] -> [G]    [H]
-
-    Lets say we want to remove B, D, and F. The new layout we need is:
-
-    Collision  | [A] ------------------------------------> [G]
-               |  :                                         :
-    Function   | [A] ----------------------> [E]            :
-               |  :                           :             :
-    Type       | [A]                          :            [G] -> [H]
-               |  :                           :             :      :
-    Collection | [A] --------> [C]           [E]           [G]    [H]
-
-    Removing B is easy, we simply set A->next_in_collection = C to bypass it.
-
-    For D, we need to work bottom up. If our node is the head of the list, we need to promote our
-    next node up a layer. If our node is also the head of the above layer, we need to recurse
-    another layer up. So since D is the head of both the collection and type linked lists, we move
-    up to the function linked list, and need to set A->next_function = E.
-
-    F exposes a further complication on top of D, since it was pointing at multiple other nodes. As
-    part of promoting a node up a layer, we need to insert it into that layer's linked list - that's
-    how we keep then link to H. In D's case, these were all null.
+#pragma endregion
 
-    Since only the heads of the lower-layer lists are used in the higher layer ones, as soon as we
-    come across a layer where we're not the head, we must be done, the lower layer nodes cannot have
-    other references to upper ones.
-    */
+}  // namespace
 
-    if (prev_in_collection != nullptr) {
-        prev_in_collection->next_in_collection = node->next_in_collection;
-        return true;
-    }
-    if (node->next_in_collection) {
-        node->next_in_collection->next_type = node->next_type;
-        node->next_type = node->next_in_collection;
-    }
+WrappedStruct ProcessEventArgs::extract(void* self) {
+    auto context = static_cast<ProcessEventArgs*>(self);
+    // Copy args so that hooks can't modify them, for parity with call function
+    const WrappedStruct args_base{context->func, context->params};
+    return args_base.copy_params_only();
+}
 
-    if (prev_type != nullptr) {
-        prev_type->next_type = node->next_type;
-        return true;
-    }
-    if (node->next_type != nullptr) {
-        node->next_type->next_function = node->next_function;
-        node->next_function = node->next_type;
-    }
+WrappedStruct CallFunctionArgs::extract(void* self) {
+    auto context = static_cast<CallFunctionArgs*>(self);
+    WrappedStruct args{context->func};
+    // Always start from the saved position, in case a previous attempt threw part way through
+    context->stack->Code = context->original_code;
+    context->stack->extract_current_args(args);
+    return args;
+}
 
-    if (prev_function != nullptr) {
-        prev_function->next_function = node->next_function;
-        return true;
-    }
-    if (node->next_function != nullptr) {
-        node->next_function->next_collision = node->next_collision;
-        node->next_collision = node->next_function;
-    }
+HookList::HookList(const FunctionHooks* hooks, const UObject* obj, ReadSection&& read)
+    : hooks(hooks), obj(obj), read(std::move(read)) {}
+
+HookList::HookList(HookList&& other) noexcept
+    : hooks(std::exchange(other.hooks, nullptr)),
+      obj(std::exchange(other.obj, nullptr)),
+      read(std::move(other.read)),
+      sample(std::exchange(other.sample, {})) {}
+
+HookList& HookList::operator=(HookList&& other) noexcept {
+    std::swap(this->hooks, other.hooks);
+    std::swap(this->obj, other.obj);
+    std::swap(this->read, other.read);
+    std::swap(this->sample, other.sample);
+    return *this;
+}
 
-    if (prev_collision != nullptr) {
-        prev_collision->next_collision = node->next_collision;
-        return true;
+HookList::~HookList() {
+    if (this->sample.func != nullptr) {
+        call_profiler::impl::finish_sample(this->sample);
     }
-    // There's no higher layer linked list left. If we have following collision entries, set the
-    // hash table to them. If we don't, we want to null it anyway.
-    hooks_hash_table.at(hash_idx) = node->next_collision;
-    return true;
 }
 
-}  // namespace
-
-std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
-                                      const UFunction* func,
-                                      const UObject* obj) {
+HookList preprocess_hook(std::wstring_view source, const UFunction* func, const UObject* obj) {
     if (should_inject_next_call) {
         should_inject_next_call = false;
-        return nullptr;
+        return {};
     }
 
     // Want to delay filling this, but if we're logging all calls we need it straight away
     std::wstring func_name{};
 
     if (should_log_all_calls) {
-        // Extra safety check
-        if (log_all_calls_stream.is_open()) {
+        if (log_all_calls_format == CallLogFormat::BINARY) {
+            binary_call_log::thread_buffer.record(source, func, obj);
+        } else if (log_all_calls_stream.is_open()) {  // Extra safety check
             func_name = func->get_path_name();
             auto obj_name = obj->get_path_name();
 
@@ -437,80 +988,202 @@ std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
         }
     }
 
-    auto fname = func->Name();
-
-    auto hash_idx = get_table_index(fname);
-    auto node = hooks_hash_table.at(hash_idx);
-    if (node == nullptr) {
-        // This function isn't even in the hash table
-        return nullptr;
-    }
+    ReadSection read{};
+    auto table = begin_read(read);
+    auto hooks = [&]() -> const FunctionHooks* {
+        if (table == nullptr) {
+            // No hooks have ever been added
+            return nullptr;
+        }
 
-    // Look through hash collisions
-    while (node->fname != fname) {
-        if (node->next_collision == nullptr) {
-            // We found a collision, but nothing matched our name
+        auto fname = func->Name();
+        auto functions = find_functions(*table, fname);
+        if (functions.empty()) {
+            // This function isn't even in the hash table
             return nullptr;
         }
-        node = node->next_collision;
-    }
 
-    // At this point we need the full path name
-    if (!should_log_all_calls) {
-        func_name = func->get_path_name();
-    }
+        // See if we've already resolved this exact function
+        if (lookup_cache.generation != table->generation) {
+            lookup_cache.entries.clear();
+            lookup_cache.generation = table->generation;
+        }
 
-    // Look though full function names
-    while (node->full_name != func_name) {
-        if (node->next_function == nullptr) {
-            // We found another function with the same fname, but nothing matches the full name
-            return nullptr;
+        const UObject* outer = func->Outer();
+        auto cached = lookup_cache.entries.find(func);
+        if (cached != lookup_cache.entries.end() && cached->second.fname == fname
+            && cached->second.outer == outer) {
+            return cached->second.hooks;
         }
-        node = node->next_function;
+
+        // At this point we need the full path name
+        if (func_name.empty()) {
+            func_name = func->get_path_name();
+        }
+
+        auto function = std::ranges::find_if(
+            functions, [&func_name](auto& function) { return function.full_name == func_name; });
+        const FunctionHooks* hooks = function == functions.end() ? nullptr : &*function;
+
+        lookup_cache.entries.insert_or_assign(func, CachedLookup{fname, outer, hooks});
+        return hooks;
+    }();
+
+    // If all hooks on this function are filtered, make sure at least one matches before we force
+    // the caller to start extracting args
+    if (hooks == nullptr
+        || (!hooks->any_unfiltered
+            && std::ranges::none_of(hooks->entries,
+                                    [obj](auto entry) { return entry->matches(obj); }))) {
+        read.exit();
+        hooks = nullptr;
     }
 
-    // Break off at this point - we know we have hooks on this function, so the hook processing will
-    // need to start extracting args.
-    return node;
+    // Break off at this point - if we have hooks on this function, the hook processing will need to
+    // start extracting args. The returned list takes ownership of our read section.
+    HookList list{hooks, obj, std::move(read)};
+    if (call_profiler::impl::enabled.load(std::memory_order_relaxed)) {
+        list.sample = call_profiler::impl::record_call(func, hooks != nullptr);
+    }
+    return list;
 }
 
-bool has_post_hooks(std::shared_ptr<Node> node) {
-    // We got the node from preprocess_hook, it's pointing to the start of the types linked list
-    for (; node != nullptr; node = node->next_type) {
-        if (node->type == Type::POST || node->type == Type::POST_UNCONDITIONAL) {
-            return true;
-        }
-    }
-    return false;
+bool has_post_hooks(const HookList& list) {
+    // Post and unconditional post hooks are adjacent, so can just check the combined range
+    const auto& offsets = list.hooks->type_offsets;
+    auto start = offsets.at(get_type_index(Type::POST));
+    auto entries = list.hooks->entries.subspan(start, offsets.at(HOOK_TYPE_COUNT) - start);
+
+    // Filtered post hooks which don't match this object won't run, so don't count them - otherwise
+    // the caller would extract args for nothing
+    return std::ranges::any_of(entries,
+                               [&list](auto entry) { return entry->matches(list.obj); });
 }
 
-bool run_hooks_of_type(std::shared_ptr<Node> node, Type type, Details& hook) {
-    // We got the node from preprocess_hook, it's pointing to the start of the types linked list
+bool run_hooks_of_type(const HookList& list, Type type, Details& hook) {
+    auto type_idx = get_type_index(type);
+    const auto& offsets = list.hooks->type_offsets;
+    auto entries = list.hooks->entries.subspan(offsets.at(type_idx),
+                                               offsets.at(type_idx + 1) - offsets.at(type_idx));
 
-    // Look through hook types
-    while (node->type != type) {
-        if (node->next_type == nullptr) {
-            // No hooks of this type - return false to not block
-            return false;
-        }
-        node = node->next_type;
-    }
+    const bool timing = hook_timing_active.load(std::memory_order_relaxed);
 
-    // We've got the final list of hooks, run them all
     bool ret = false;
-    for (; node != nullptr; node = node->next_in_collection) {
+    for (auto entry : entries) {
+        if (!entry->matches(hook.obj)) {
+            continue;
+        }
+
+        std::chrono::steady_clock::time_point start{};
+        if (timing) {
+            start = std::chrono::steady_clock::now();
+        }
+
         try {
-            ret |= node->callback(hook);
+            ret |= entry->callback(hook);
         } catch (const std::exception& ex) {
+            entry->exceptions.fetch_add(1, std::memory_order_relaxed);
             LOG(ERROR, "An exception occurred during hook processing");
             LOG(ERROR, L"Function: {}", hook.func.func->get_path_name());
             LOG(ERROR, "Exception: {}", ex.what());
         }
+
+        if (timing) {
+            record_hook_time(*entry, type, hook, std::chrono::steady_clock::now() - start);
+        }
     }
 
     return ret;
 }
 
+namespace {
+
+const constexpr size_t DEFAULT_TOP_HOOK_COUNT = 20;
+
+/**
+ * @brief Callback for the hook stats console command.
+ *
+ * @param line The full line which triggered the callback.
+ * @param size The number of characters in the line.
+ * @param cmd_len The length of the matched command.
+ */
+void hook_stats_command_callback(const wchar_t* line, size_t size, size_t cmd_len) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::wistringstream args{std::wstring{line + cmd_len, size - cmd_len}};
+
+    std::wstring action{};
+    args >> action;
+    std::ranges::transform(action, action.begin(), &std::towlower);
+
+    if (action == L"start") {
+        should_time_hooks = true;
+        update_hook_timing_active();
+        LOG(INFO, "Started timing hooks");
+    } else if (action == L"stop") {
+        should_time_hooks = false;
+        update_hook_timing_active();
+        LOG(INFO, "Stopped timing hooks");
+    } else if (action == L"reset") {
+        reset_hook_stats();
+        LOG(INFO, "Reset hook stats");
+    } else if (action == L"threshold") {
+        int64_t threshold_us{};
+        if (args >> threshold_us) {
+            hook_manager::set_slow_hook_threshold(std::chrono::microseconds{threshold_us});
+        }
+        LOG(INFO, "Logging hooks slower than {}us", slow_hook_threshold_ns.load() / 1000);
+    } else if (action == L"top") {
+        size_t count{};
+        if (!(args >> count)) {
+            count = DEFAULT_TOP_HOOK_COUNT;
+        }
+
+        auto stats = hook_manager::get_hook_stats();
+        std::ranges::sort(stats, std::greater{}, &HookStats::total_time);
+        count = std::min(count, stats.size());
+
+        LOG(INFO, "Top {} of {} hooks, by total time:", count, stats.size());
+        LOG(INFO, "{:>10} {:>12} {:>12} {:>12} {:>6}  {}", "Calls", "Total", "Avg", "Max", "Errors",
+            "Hook");
+        for (const auto& hook : std::span{stats}.first(count)) {
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            auto avg_time = hook.calls == 0 ? microseconds{0}
+                                            : duration_cast<microseconds>(hook.total_time)
+                                                  / static_cast<int64_t>(hook.calls);
+
+            LOG(INFO, L"{:>10} {:>10}us {:>10}us {:>10}us {:>6}  {} {} '{}'", hook.calls,
+                duration_cast<microseconds>(hook.total_time).count(), avg_time.count(),
+                duration_cast<microseconds>(hook.max_time).count(), hook.exceptions,
+                get_type_name(hook.type), hook.func, hook.identifier);
+        }
+    } else {
+        LOG(INFO, "Usage:");
+        LOG(INFO, "  start            Starts timing hooks");
+        LOG(INFO, "  stop             Stops timing hooks, keeping the stats");
+        LOG(INFO, "  reset            Clears the stats");
+        LOG(INFO, "  top [count]      Prints the slowest hooks, by total time");
+        LOG(INFO, "  threshold [us]   Logs any hook slower than this, 0 to disable");
+    }
+}
+
+}  // namespace
+
+void init(void) {
+    should_time_hooks = config::get_bool("unrealsdk.time_hooks").value_or(false);
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    slow_hook_threshold_ns = config::get_int<uint64_t>("unrealsdk.slow_hook_threshold_us")
+                                 .value_or(0)
+                             * 1000;
+    update_hook_timing_active();
+
+    auto command =
+        config::get_str("unrealsdk.hook_stats_command").value_or("unrealsdk_hook_stats");
+    if (!command.empty()) {
+        commands::add_command(utils::widen(command), &hook_stats_command_callback);
+    }
+}
+
 }  // namespace impl
 #endif
 #pragma endregion
@@ -551,7 +1224,10 @@ UNREALSDK_CAPI(bool,
                Type type,
                const wchar_t* identifier,
                size_t identifier_size,
-               DLLSafeCallback&& callback);
+               const UObject* obj_filter,
+               const UClass* cls_filter,
+               DLLSafeCallback&& callback,
+               int32_t priority);
 #endif
 #ifndef UNREALSDK_IMPORTING
 UNREALSDK_CAPI(bool,
@@ -561,19 +1237,47 @@ UNREALSDK_CAPI(bool,
                Type type,
                const wchar_t* identifier,
                size_t identifier_size,
-               DLLSafeCallback&& callback) {
-    return impl::add_hook({func, func_size}, type, {identifier, identifier_size},
-                          std::move(callback));
+               const UObject* obj_filter,
+               const UClass* cls_filter,
+               DLLSafeCallback&& callback,
+               int32_t priority) {
+    return impl::add_hook({func, func_size}, type, {identifier, identifier_size}, obj_filter,
+                          cls_filter, std::move(callback), priority);
 }
 #endif
 
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              const Callback& callback) {
+              const Callback& callback,
+              int32_t priority) {
     // NOLINTBEGIN(cppcoreguidelines-owning-memory)
     return UNREALSDK_MANGLE(add_hook)(func.data(), func.size(), type, identifier.data(),
-                                      identifier.size(), {callback});
+                                      identifier.size(), nullptr, nullptr, {callback}, priority);
+    // NOLINTEND(cppcoreguidelines-owning-memory)
+}
+
+bool add_hook(std::wstring_view func,
+              Type type,
+              std::wstring_view identifier,
+              const UObject* obj_filter,
+              const Callback& callback,
+              int32_t priority) {
+    // NOLINTBEGIN(cppcoreguidelines-owning-memory)
+    return UNREALSDK_MANGLE(add_hook)(func.data(), func.size(), type, identifier.data(),
+                                      identifier.size(), obj_filter, nullptr, {callback}, priority);
+    // NOLINTEND(cppcoreguidelines-owning-memory)
+}
+
+bool add_hook(std::wstring_view func,
+              Type type,
+              std::wstring_view identifier,
+              const UClass* cls_filter,
+              const Callback& callback,
+              int32_t priority) {
+    // NOLINTBEGIN(cppcoreguidelines-owning-memory)
+    return UNREALSDK_MANGLE(add_hook)(func.data(), func.size(), type, identifier.data(),
+                                      identifier.size(), nullptr, cls_filter, {callback}, priority);
     // NOLINTEND(cppcoreguidelines-owning-memory)
 }
 
@@ -631,6 +1335,113 @@ bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier
                                          identifier.size());
 }
 
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, time_hooks, bool should_time);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, time_hooks, bool should_time) {
+    impl::should_time_hooks = should_time;
+    impl::update_hook_timing_active();
+}
+#endif
+void time_hooks(bool should_time) {
+    UNREALSDK_MANGLE(time_hooks)(should_time);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, set_slow_hook_threshold, uint64_t threshold_us);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, set_slow_hook_threshold, uint64_t threshold_us) {
+    // Saturate rather than overflowing when converting to nanoseconds
+    const constexpr uint64_t MAX_THRESHOLD_US = std::numeric_limits<uint64_t>::max() / 1000;
+    impl::slow_hook_threshold_ns = std::min(threshold_us, MAX_THRESHOLD_US) * 1000;
+    impl::update_hook_timing_active();
+}
+#endif
+void set_slow_hook_threshold(std::chrono::microseconds threshold) {
+    // Negative thresholds would wrap around to huge ones, treat them as disabling it instead
+    UNREALSDK_MANGLE(set_slow_hook_threshold)(
+        static_cast<uint64_t>(std::max(threshold.count(), std::chrono::microseconds::rep{0})));
+}
+
+/// A view of a hook's stats, passed across the dll boundary.
+struct HookStatsView {
+    const wchar_t* func;
+    size_t func_size;
+    Type type;
+    const wchar_t* identifier;
+    size_t identifier_size;
+    uint64_t calls;
+    uint64_t exceptions;
+    uint64_t total_ns;
+    uint64_t max_ns;
+};
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void,
+               visit_hook_stats,
+               void (*callback)(void* ctx, const HookStatsView* stats),
+               void* ctx);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void,
+               visit_hook_stats,
+               void (*callback)(void* ctx, const HookStatsView* stats),
+               void* ctx) {
+    const std::lock_guard<std::mutex> lock(impl::hooks_mutex);
+    for (const auto& [fname, functions] : impl::registered_hooks) {
+        for (const auto& function : functions) {
+            for (size_t type_idx = 0; type_idx < impl::HOOK_TYPE_COUNT; type_idx++) {
+                for (const auto& entry : function.hooks.at(type_idx)) {
+                    const HookStatsView view{
+                        .func = function.full_name.data(),
+                        .func_size = function.full_name.size(),
+                        .type = static_cast<Type>(type_idx),
+                        .identifier = entry->identifier.data(),
+                        .identifier_size = entry->identifier.size(),
+                        .calls = entry->calls.load(std::memory_order_relaxed),
+                        .exceptions = entry->exceptions.load(std::memory_order_relaxed),
+                        .total_ns = entry->total_ns.load(std::memory_order_relaxed),
+                        .max_ns = entry->max_ns.load(std::memory_order_relaxed),
+                    };
+                    callback(ctx, &view);
+                }
+            }
+        }
+    }
+}
+#endif
+std::vector<HookStats> get_hook_stats(void) {
+    std::vector<HookStats> stats{};
+    UNREALSDK_MANGLE(visit_hook_stats)(
+        [](void* ctx, const HookStatsView* view) {
+            static_cast<std::vector<HookStats>*>(ctx)->push_back({
+                .func = {view->func, view->func_size},
+                .type = view->type,
+                .identifier = {view->identifier, view->identifier_size},
+                .calls = view->calls,
+                .exceptions = view->exceptions,
+                .total_time = std::chrono::nanoseconds{view->total_ns},
+                .max_time = std::chrono::nanoseconds{view->max_ns},
+            });
+        },
+        &stats);
+    return stats;
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, reset_hook_stats);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, reset_hook_stats) {
+    impl::reset_hook_stats();
+}
+#endif
+void reset_hook_stats(void) {
+    UNREALSDK_MANGLE(reset_hook_stats)();
+}
+
 }  // namespace unrealsdk::hook_manager
 
 #pragma endregion
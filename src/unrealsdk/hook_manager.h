@@ -2,28 +2,79 @@
 #define UNREALSDK_HOOK_MANAGER_H
 
 #include "unrealsdk/pch.h"
+#include "unrealsdk/call_profiler.h"
 #include "unrealsdk/unreal/wrappers/bound_function.h"
 #include "unrealsdk/unreal/wrappers/property_proxy.h"
+#include "unrealsdk/unreal/wrappers/wrapped_struct.h"
 
 namespace unrealsdk::unreal {
 
 class UObject;
+class UClass;
 class UFunction;
 
-class WrappedStruct;
+struct FFrame;
 
 }  // namespace unrealsdk::unreal
 
 namespace unrealsdk::hook_manager {
 
 /// What type of hook to add - i.e. when the callback runs
-/// Note that the order callbacks within the same type (on the same function) are run is undefined.
+/// Callbacks within the same type (on the same function) are run in order of descending priority,
+/// hooks with equal priority are run in the order they were added.
 enum class Type : uint8_t {
     PRE,                 /// Before running the hooked function.
     POST,                /// After the hooked function, only if it was allowed to run.
     POST_UNCONDITIONAL,  /// After the hooked function, even if it got blocked.
 };
 
+/// The arguments a hooked function was called with, which are only extracted on first access.
+class LazyArgs {
+   public:
+    /**
+     * @brief A function which extracts the args.
+     *
+     * @param context The context pointer given alongside the extractor.
+     * @return The extracted args.
+     */
+    using Extractor = unreal::WrappedStruct (*)(void* context);
+
+   private:
+    Extractor extractor;
+    void* context;
+    mutable std::optional<unreal::WrappedStruct> args;
+
+   public:
+    /**
+     * @brief Constructs a new set of lazy args.
+     *
+     * @param extractor The function to call to extract the args.
+     * @param context An arbitrary context pointer to pass to the extractor.
+     */
+    LazyArgs(Extractor extractor, void* context) : extractor(extractor), context(context) {}
+
+    /**
+     * @brief Gets the args, extracting them if this is the first access.
+     *
+     * @return A reference to the args.
+     */
+    unreal::WrappedStruct& get(void) const {
+        if (!this->args.has_value()) {
+            this->args.emplace(this->extractor(this->context));
+        }
+        return *this->args;
+    }
+    unreal::WrappedStruct* operator->(void) const { return &this->get(); }
+    unreal::WrappedStruct& operator*(void) const { return this->get(); }
+
+    /**
+     * @brief Checks if the args have already been extracted.
+     *
+     * @return True if the args have been extracted.
+     */
+    [[nodiscard]] bool has_value(void) const { return this->args.has_value(); }
+};
+
 /// Information about a hooked function call
 struct Details {
     /// The object the hooked function was called on.
@@ -31,7 +82,8 @@ struct Details {
 
     /// The arguments the hooked function was called with. While this is mutable, modifying it will
     /// *not* modify the actual function arguments.
-    unreal::WrappedStruct* args{};
+    /// These are extracted on first access, hooks which don't look at them don't pay for them.
+    LazyArgs args;
 
     /// A proxy for the return value. During pre-hooks, it's an unset value, and setting it will
     /// overwrite the return value of the function call. Whatever value is set when pre-hook
@@ -52,7 +104,8 @@ struct Details {
  *
  * @param hook The hook details.
  * @return In pre-hooks: If to block execution - if any pre-hook returns true, the unreal function
- *                       will not be run.
+ *                       will not be run. All pre-hooks are still run, regardless of if an earlier
+ *                       one already decided to block.
  *         In post-hooks: ignored.
  */
 using Callback = std::function<bool(Details&)>;
@@ -60,6 +113,8 @@ using Callback = std::function<bool(Details&)>;
 /**
  * @brief Toggles logging all unreal function calls. Best used in short bursts for debugging.
  * @note This writes to it's own dedicated file, rather than going through the logging system.
+ * @note The `unrealsdk.log_all_calls_format` setting switches between a human readable TSV file,
+ *       and a much faster compact binary trace, documented in `hook_manager.cpp`.
  *
  * @param should_log True to turn on logging all calls, false to turn it off.
  */
@@ -78,12 +133,56 @@ void inject_next_call(void);
  * @param type Which type of hook to add.
  * @param identifier The hook identifier.
  * @param callback The callback to run when the hooked function is called.
+ * @param priority The hook's priority. Higher priority hooks run first.
  * @return True if successfully added, false if an identical hook already existed.
  */
 bool add_hook(std::wstring_view func,
               Type type,
               std::wstring_view identifier,
-              const Callback& callback);
+              const Callback& callback,
+              int32_t priority = 0);
+
+/**
+ * @brief Adds a hook which only runs when the function is called on a specific object.
+ * @note Non-matching calls are discarded before any args are extracted, so this is cheaper than
+ *       checking the object inside the callback.
+ * @note The filter is only compared by pointer - the hook should be removed before the object is
+ *       destroyed, otherwise it may start matching a new object allocated in the same spot.
+ *
+ * @param func The function to hook.
+ * @param type Which type of hook to add.
+ * @param identifier The hook identifier.
+ * @param obj_filter The object to filter calls to.
+ * @param callback The callback to run when the hooked function is called.
+ * @param priority The hook's priority. Higher priority hooks run first.
+ * @return True if successfully added, false if an identical hook already existed.
+ */
+bool add_hook(std::wstring_view func,
+              Type type,
+              std::wstring_view identifier,
+              const unreal::UObject* obj_filter,
+              const Callback& callback,
+              int32_t priority = 0);
+
+/**
+ * @brief Adds a hook which only runs when the function is called on an instance of a class.
+ * @note Non-matching calls are discarded before any args are extracted, so this is cheaper than
+ *       checking the object inside the callback.
+ *
+ * @param func The function to hook.
+ * @param type Which type of hook to add.
+ * @param identifier The hook identifier.
+ * @param cls_filter The class to filter calls to. Subclasses also match.
+ * @param callback The callback to run when the hooked function is called.
+ * @param priority The hook's priority. Higher priority hooks run first.
+ * @return True if successfully added, false if an identical hook already existed.
+ */
+bool add_hook(std::wstring_view func,
+              Type type,
+              std::wstring_view identifier,
+              const unreal::UClass* cls_filter,
+              const Callback& callback,
+              int32_t priority = 0);
 
 /**
  * @brief Checks if a hook exists.
@@ -105,10 +204,96 @@ bool has_hook(std::wstring_view func, Type type, std::wstring_view identifier);
  */
 bool remove_hook(std::wstring_view func, Type type, std::wstring_view identifier);
 
+/// Timing statistics for a single hook.
+struct HookStats {
+    std::wstring func;
+    Type type;
+    std::wstring identifier;
+
+    /// How many times the hook ran while timing was enabled.
+    uint64_t calls;
+    /// How many times the hook threw an exception. Counted even while timing is disabled.
+    uint64_t exceptions;
+    /// The total time spent in the hook.
+    std::chrono::nanoseconds total_time;
+    /// The longest single run of the hook.
+    std::chrono::nanoseconds max_time;
+};
+
+/**
+ * @brief Toggles timing how long each hook takes to run.
+ * @note Statistics are stored per hook, and are discarded when the hook is removed.
+ *
+ * @param should_time True to start timing hooks, false to stop. Stopping keeps all statistics.
+ */
+void time_hooks(bool should_time);
+
+/**
+ * @brief Sets a threshold above which any hook which runs is logged as slow.
+ * @note Works independently of `time_hooks`.
+ *
+ * @param threshold The threshold, or 0 to disable logging slow hooks. Negative values are treated
+ *                  as 0.
+ */
+void set_slow_hook_threshold(std::chrono::microseconds threshold);
+
+/**
+ * @brief Gets the timing statistics of all current hooks.
+ *
+ * @return The statistics of every hook.
+ */
+[[nodiscard]] std::vector<HookStats> get_hook_stats(void);
+
+/**
+ * @brief Resets the timing statistics of all current hooks.
+ */
+void reset_hook_stats(void);
+
 #ifndef UNREALSDK_IMPORTING
 namespace impl {  // These functions are only relevant when implementing a game hook
 
-struct Node;
+struct FunctionHooks;
+class ReadSection;
+class HookList;
+
+/**
+ * @brief Initializes the hook manager, registering it's console command.
+ */
+void init(void);
+
+/// Context required to lazily extract the args of a ProcessEvent call.
+struct ProcessEventArgs {
+    const unreal::UFunction* func;
+    void* params;
+
+    /**
+     * @brief Extracts the args, by copying them out of the params struct.
+     *
+     * @param self Pointer to the context struct.
+     * @return The extracted args.
+     */
+    static unreal::WrappedStruct extract(void* self);
+};
+
+/// Context required to lazily extract the args of a CallFunction call.
+struct CallFunctionArgs {
+    const unreal::UFunction* func;
+    unreal::FFrame* stack;
+    // The original position of the stack's code pointer. Must be saved before any extraction, so
+    // it can still be restored if extraction throws part way through.
+    uint8_t* original_code;
+
+    /**
+     * @brief Extracts the args, by stepping through the stack.
+     * @note Steps the stack's code pointer, the caller must restore it from `original_code` or step
+     *       over the end of function params token as appropriate. Args must be extracted before the
+     *       function is run.
+     *
+     * @param self Pointer to the context struct.
+     * @return The extracted args.
+     */
+    static unreal::WrappedStruct extract(void* self);
+};
 
 /*
 Processing hooks needs to be very optimized, thousands if not tens of thousands of functions calls
@@ -120,17 +305,24 @@ even be able to do so for every single call (have to assume functions like that
 To deal with this, hook processing is split in three.
 
 Firstly, call `preprocess_hook`. This does some basic logging (if required), and then determines if
-the function is hooked. If it isn't, it returns `nullptr`, and calling code can early exit. If there
-is, it returns the list of hooks, to be passed to the next step.
+the function is hooked. If it isn't, it returns an empty list, and calling code can early exit. If
+there is, it returns the list of hooks, to be passed to the next step.
 
 If there is a hook, calling code can then spend more time retrieving the remaining information,
-before calling `run_hooks_of_type` using pre-hooks. This actually runs all the hooks, and returns
+before calling `run_hooks_of_type` using pre-hooks. Args are filled lazily, using one of the context
+structs below, so they're only extracted if a hook actually looks at them. This actually runs all the hooks, and returns
 the logical or of their return values. It can then run the unreal function or block execution as
 required.
 
 Extracting the return value may not be trivial either, so the calling code can run `has_post_hooks`
 to work out if to early exit again. If it does, it can spend a bit longer extracting it, then call
-`run_hooks_of_type` with the two post-hook types.
+`run_hooks_of_type` with the two post-hook types. If there are post-hooks, the args should be
+extracted before running the unreal function, so that they see the same values pre-hooks do.
+
+The hook list keeps the hooks it references alive, and should be destroyed as soon as the call is
+complete. Hooks added or removed while it's alive will only take effect on the next call. When the
+call profiler is enabled, the hook list is also used to time the call, so it should be kept alive
+until the unreal function returns - even if it's empty.
 */
 
 /**
@@ -139,29 +331,94 @@ to work out if to early exit again. If it does, it can spend a bit longer extrac
  * @param source The source of the call, used for logging.
  * @param func The function which was called.
  * @param obj The object which called the function.
- * @return A node pointer to pass into the following functions, or nullptr if no hooks match.
+ * @return The list of hooks to pass into the following functions, which compares equal to nullptr
+ *         if no hooks match, taking object filters into account.
  */
-std::shared_ptr<Node> preprocess_hook(std::wstring_view source,
-                                      const unreal::UFunction* func,
-                                      const unreal::UObject* obj);
+HookList preprocess_hook(std::wstring_view source,
+                         const unreal::UFunction* func,
+                         const unreal::UObject* obj);
 
 /**
  * @brief Checks if a hook list contains any post hooks.
  *
- * @param node The node previously retrieved from `preprocess_hook`.
- * @return True if the list contains post hooks.
+ * @param list The list previously retrieved from `preprocess_hook`.
+ * @return True if the list contains post hooks which match the called object.
  */
-bool has_post_hooks(std::shared_ptr<Node> node);
+bool has_post_hooks(const HookList& list);
 
 /**
  * @brief Runs all the hooks in a list which match the given type.
  *
- * @param node The node previously retrieved from `preprocess_hook`.
+ * @param list The list previously retrieved from `preprocess_hook`.
  * @param type The type of hooks to run.
  * @param hook The hook details.
  * @return The logical or of the hooks' return values.
  */
-bool run_hooks_of_type(std::shared_ptr<Node> node, Type type, Details& hook);
+bool run_hooks_of_type(const HookList& list, Type type, Details& hook);
+
+/**
+ * @brief RAII guard over a hook table read section. While one is open, the tables it may have read
+ *        from won't be freed.
+ */
+class ReadSection {
+   private:
+    bool active = false;
+
+   public:
+    ReadSection(void) = default;
+    ~ReadSection();
+
+    ReadSection(const ReadSection&) = delete;
+    ReadSection(ReadSection&& other) noexcept;
+    ReadSection& operator=(const ReadSection&) = delete;
+    ReadSection& operator=(ReadSection&& other) noexcept;
+
+    /**
+     * @brief Enters a new read section.
+     *
+     * @return The guard over the section.
+     */
+    [[nodiscard]] static ReadSection enter(void);
+
+    /**
+     * @brief Exits the read section early. Does nothing if it's already been exited.
+     */
+    void exit(void);
+};
+
+class HookList {
+   private:
+    const FunctionHooks* hooks = nullptr;
+    // The object the function was called on, used to check filters
+    const unreal::UObject* obj = nullptr;
+    // Keeps the table the hooks point into alive
+    ReadSection read;
+    call_profiler::impl::Sample sample;
+
+    HookList(const FunctionHooks* hooks, const unreal::UObject* obj, ReadSection&& read);
+
+    friend HookList preprocess_hook(std::wstring_view source,
+                                    const unreal::UFunction* func,
+                                    const unreal::UObject* obj);
+    friend bool has_post_hooks(const HookList& list);
+    friend bool run_hooks_of_type(const HookList& list, Type type, Details& hook);
+
+   public:
+    HookList(void) = default;
+    ~HookList();
+
+    HookList(const HookList&) = delete;
+    HookList(HookList&& other) noexcept;
+    HookList& operator=(const HookList&) = delete;
+    HookList& operator=(HookList&& other) noexcept;
+
+    /**
+     * @brief Checks if this list is empty, i.e. the function was not hooked.
+     *
+     * @return True if the list is empty.
+     */
+    bool operator==(std::nullptr_t) const { return this->hooks == nullptr; }
+};
 
 }  // namespace impl
 #endif
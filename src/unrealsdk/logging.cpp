@@ -9,43 +9,310 @@ namespace unrealsdk::logging {
 
 namespace {
 
+/**
+ * @brief Gets the current unix time in milliseconds.
+ *
+ * @return The unix time milliseconds.
+ */
+uint64_t unix_ms_now(void) {
+    auto time = std::chrono::system_clock::now();
+    return std::chrono::round<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
 #ifndef UNREALSDK_IMPORTING
+
+#pragma region Message Queue
+
 // We push log messages into a queue, to be written by another thread
 // This means we need to own the strings - the raw LogMessage is just a reference type for callbacks
-struct OwnedLogMessage : public LogMessage {
+// To avoid allocating, short messages are stored inline
+struct QueuedLogMessage {
    private:
-    std::string msg_str;
-    std::string location_str;
+    static constexpr size_t INLINE_SIZE = 256;
+
+    uint64_t unix_time_ms{};
+    Level level{};
+    int line{};
+    size_t msg_size{};
+    size_t location_size{};
+
+    // If set, the message needs to be formatted using this formatter and format string
+    impl::deferred_formatter formatter{};
+    std::string_view format_str;
+    size_t args_size{};
+
+    // The message followed by the location, stored inline if possible, or on the heap if not
+    // Deferred messages instead store the location followed by the packed args, always inline
+    std::array<char, INLINE_SIZE> inline_data{};
+    std::string heap_data;
 
    public:
-    OwnedLogMessage(uint64_t unix_time_ms,
-                    Level level,
-                    const char* msg,
-                    size_t msg_size,
-                    const char* location,
-                    size_t location_size,
-                    int line)
-        : LogMessage(unix_time_ms, level, nullptr, 0, nullptr, 0, line),
-          msg_str{msg, msg_size},
-          location_str{location, location_size} {}
+    /**
+     * @brief Checks if a deferred message can be stored in a queue entry.
+     *
+     * @param location_size The size of the message's location.
+     * @param args_size The size of the packed format args.
+     * @return True if it can be deferred.
+     */
+    static bool can_defer(size_t location_size, size_t args_size) {
+        return location_size + args_size <= INLINE_SIZE;
+    }
 
     /**
-     * @brief Fills in the string pointers and decays back into a raw log message.
+     * @brief Copies a log message into this queue entry.
      *
-     * @return A pointer to this message.
+     * @param unix_time_ms The time the message was logged.
+     * @param level The message's log level.
+     * @param msg The message.
+     * @param location The location the message was logged from.
+     * @param line The line the message was logged from.
      */
-    LogMessage* as_ptr(void) {
-        this->msg = this->msg_str.data();
-        this->msg_size = this->msg_str.size();
-        this->location = this->location_str.data();
-        this->location_size = this->location_str.size();
-        return this;
+    void assign(uint64_t unix_time_ms,
+                Level level,
+                std::string_view msg,
+                std::string_view location,
+                int line) {
+        this->unix_time_ms = unix_time_ms;
+        this->level = level;
+        this->line = line;
+        this->msg_size = msg.size();
+        this->location_size = location.size();
+        this->formatter = nullptr;
+
+        if (msg.size() + location.size() <= INLINE_SIZE) {
+            std::ranges::copy(location, std::ranges::copy(msg, this->inline_data.begin()).out);
+            this->heap_data.clear();
+        } else {
+            this->heap_data.reserve(msg.size() + location.size());
+            this->heap_data.assign(msg).append(location);
+        }
+    }
+
+    /**
+     * @brief Copies a deferred log message into this queue entry.
+     * @note Must check `can_defer` first.
+     *
+     * @param unix_time_ms The time the message was logged.
+     * @param level The message's log level.
+     * @param format_str The format string.
+     * @param formatter The function to format the message with.
+     * @param args The packed format args.
+     * @param location The location the message was logged from.
+     * @param line The line the message was logged from.
+     */
+    void assign_deferred(uint64_t unix_time_ms,
+                         Level level,
+                         std::string_view format_str,
+                         impl::deferred_formatter formatter,
+                         std::string_view args,
+                         std::string_view location,
+                         int line) {
+        this->unix_time_ms = unix_time_ms;
+        this->level = level;
+        this->line = line;
+        this->msg_size = 0;
+        this->location_size = location.size();
+        this->formatter = formatter;
+        this->format_str = format_str;
+        this->args_size = args.size();
+
+        std::ranges::copy(args, std::ranges::copy(location, this->inline_data.begin()).out);
+        this->heap_data.clear();
     }
+
+    /**
+     * @brief Gets a raw log message referencing this entry.
+     *
+     * @param buffer A buffer to format deferred messages into. The returned message may reference
+     *               it, so it must outlive it.
+     * @return The log message.
+     */
+    [[nodiscard]] LogMessage as_message(std::string& buffer) const {
+        if (this->formatter != nullptr) {
+            auto location = this->inline_data.data();
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto args = location + this->location_size;
+
+            // This runs on the logger thread, where there's nothing to catch an exception - and
+            // letting one escape would leave the queue wedged. Log what we can instead.
+            try {
+                buffer.resize(buffer.capacity());
+                auto size = this->formatter(this->format_str.data(), this->format_str.size(), args,
+                                            buffer.data(), buffer.size());
+                if (size > buffer.size()) {
+                    buffer.resize(size);
+                    this->formatter(this->format_str.data(), this->format_str.size(), args,
+                                    buffer.data(), buffer.size());
+                }
+                buffer.resize(size);
+            } catch (const std::exception& ex) {
+                this->format_error(buffer, ex.what());
+            } catch (...) {
+                this->format_error(buffer, "unknown exception");
+            }
+
+            return {.unix_time_ms = this->unix_time_ms,
+                    .level = this->level,
+                    .msg = buffer.data(),
+                    .msg_size = buffer.size(),
+                    .location = location,
+                    .location_size = this->location_size,
+                    .line = this->line};
+        }
+
+        const char* data = this->heap_data.empty() ? this->inline_data.data()
+                                                   : this->heap_data.data();
+        return {.unix_time_ms = this->unix_time_ms,
+                .level = this->level,
+                .msg = data,
+                .msg_size = this->msg_size,
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                .location = data + this->msg_size,
+                .location_size = this->location_size,
+                .line = this->line};
+    }
+
+   private:
+    /**
+     * @brief Writes a fallback message into the buffer, after a deferred message failed to format.
+     *
+     * @param buffer The buffer to write to.
+     * @param error A description of the error.
+     */
+    void format_error(std::string& buffer, std::string_view error) const {
+        buffer.assign("<format error: ");
+        buffer.append(error);
+        buffer.append("> ");
+        buffer.append(this->format_str);
+    }
+};
+
+/*
+A bounded, lock-free, multi-producer multi-consumer ring buffer, based on Dmitry Vyukov's design.
+
+Each cell has a sequence number, which tells both producers and consumers if it's their turn to use
+it. Claiming a cell is a single compare exchange on the relevant position, after which the cell is
+exclusively owned until it's sequence number is bumped.
+
+While the logger thread is the only real consumer, producers also need to be able to pop entries, to
+be able to drop the oldest message when full.
+*/
+class MessageQueue {
+   public:
+    static constexpr size_t SIZE = 4096;
+    static_assert(std::has_single_bit(SIZE), "queue size must be a power of two");
+
+   private:
+    static constexpr size_t MASK = SIZE - 1;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        QueuedLogMessage msg;
+    };
+
+    std::unique_ptr<Cell[]> cells;  // NOLINT(modernize-avoid-c-arrays)
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> enqueue_pos{0};
+    alignas(std::hardware_destructive_interference_size) std::atomic<size_t> dequeue_pos{0};
+
+   public:
+    // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+    MessageQueue(void) : cells(std::make_unique<Cell[]>(SIZE)) {
+        for (size_t i = 0; i < SIZE; i++) {
+            this->cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Tries to push a message onto the queue.
+     *
+     * @param func A function to fill in the message, called while the cell is owned.
+     * @return True if the message was pushed, false if the queue was full.
+     */
+    template <typename Func>
+    bool try_push(Func&& func) {
+        auto pos = this->enqueue_pos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &this->cells[pos & MASK];
+            auto seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        func(cell->msg);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Tries to pop a message off of the queue.
+     *
+     * @param func A function to process the message, called while the cell is owned. Should be
+     *             kept short, since producers can't reuse the cell until it returns.
+     * @return True if a message was popped, false if the queue was empty.
+     */
+    template <typename Func>
+    bool try_pop(Func&& func) {
+        auto pos = this->dequeue_pos.load(std::memory_order_relaxed);
+        Cell* cell = nullptr;
+        while (true) {
+            cell = &this->cells[pos & MASK];
+            auto seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+            if (diff == 0) {
+                if (this->dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                            std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = this->dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        func(cell->msg);
+        cell->sequence.store(pos + SIZE, std::memory_order_release);
+        return true;
+    }
+};
+
+/// What to do when a message is logged while the queue is full.
+enum class OverflowPolicy : uint8_t {
+    /// Wait for the logger thread to make space.
+    BLOCK,
+    /// Drop the oldest message in the queue, or the new one if that still doesn't free up space.
+    DROP_OLDEST,
+    /// Drop the new message.
+    DROP_NEWEST,
 };
 
-std::mutex pending_messages_mutex{};
-std::queue<OwnedLogMessage> pending_messages{};
-std::condition_variable pending_messages_available{};
+MessageQueue pending_messages{};
+// Bumped whenever a message is pushed, so the logger thread can wait on it
+std::atomic<uint32_t> pending_messages_counter{0};
+// Set while the logger thread is (about to be) waiting on the counter, so that producers only pay
+// for a notify when there's someone to wake. Both this and the counter use seq cst, so either the
+// producer sees the flag, or the logger thread sees the new counter value and doesn't sleep.
+std::atomic<bool> logger_sleeping{false};
+// Set on the logger thread, which can't wait on itself to make space in the queue
+thread_local bool is_logger_thread = false;
+
+std::atomic<Level> log_level{Level::MIN};
+std::atomic<OverflowPolicy> overflow_policy{OverflowPolicy::DROP_OLDEST};
+std::atomic<size_t> dropped_messages{0};
+
+#pragma endregion
 
 Level unreal_console_level = Level::DEFAULT_CONSOLE_LEVEL;
 HANDLE external_console_handle = nullptr;
@@ -58,30 +325,51 @@ std::vector<log_callback> all_log_callbacks{};
 
 [[noreturn]] void logger_thread(void) {
     SetThreadDescription(GetCurrentThread(), L"unrealsdk logger");
+    is_logger_thread = true;
+
+    // Reused between deferred messages, so we only need to allocate when one is longer than usual
+    std::string format_buffer{};
+    // Messages get swapped out of the queue into here before running callbacks, so we release each
+    // cell straight away, rather than holding onto it (and blocking producers) for the entire time
+    // the (potentially slow) callbacks run. Swapping rather than moving also hands the cell back
+    // this message's old heap buffer, so it can be reused.
+    QueuedLogMessage current{};
 
     while (true) {
-        std::unique_lock<std::mutex> pending_messages_lock(pending_messages_mutex);
-        if (pending_messages.empty()) {
-            pending_messages_available.wait(pending_messages_lock,
-                                            []() { return !pending_messages.empty(); });
-        }
+        auto counter = pending_messages_counter.load(std::memory_order_acquire);
 
         {
             const std::lock_guard<std::mutex> callback_lock(callback_mutex);
-            while (!pending_messages.empty()) {
-                auto msg = std::move(pending_messages.front());
-                pending_messages.pop();
-
-                pending_messages_lock.unlock();
-
-                auto ptr = msg.as_ptr();
+            auto run_callbacks = [](const LogMessage& msg) {
                 for (const auto& callback : all_log_callbacks) {
-                    callback(ptr);
+                    callback(&msg);
                 }
+            };
 
-                pending_messages_lock.lock();
+            while (pending_messages.try_pop(
+                [&current](QueuedLogMessage& queued) { std::swap(current, queued); })) {
+                run_callbacks(current.as_message(format_buffer));
+            }
+
+            auto dropped = dropped_messages.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0) {
+                auto str = std::format("Log queue overflowed, dropped {} messages", dropped);
+                run_callbacks({.unix_time_ms = unix_ms_now(),
+                               .level = Level::WARNING,
+                               .msg = str.data(),
+                               .msg_size = str.size(),
+                               .location = __FUNCTION__,
+                               .location_size = sizeof(__FUNCTION__) - 1,
+                               .line = __LINE__});
             }
         }
+
+        // Only sleep if nothing new was pushed while we were processing
+        logger_sleeping.store(true);
+        if (pending_messages_counter.load() == counter) {
+            pending_messages_counter.wait(counter);
+        }
+        logger_sleeping.store(false, std::memory_order_relaxed);
     }
 }
 
@@ -90,16 +378,6 @@ std::vector<log_callback> all_log_callbacks{};
 
 #pragma region Conversions
 
-/**
- * @brief Gets the current unix time in milliseconds.
- *
- * @return The unix time milliseconds.
- */
-uint64_t unix_ms_now(void) {
-    auto time = std::chrono::system_clock::now();
-    return std::chrono::round<std::chrono::milliseconds>(time.time_since_epoch()).count();
-}
-
 #ifndef UNREALSDK_IMPORTING
 /**
  * @brief Gets a system clock time point from unix time milliseconds.
@@ -281,6 +559,53 @@ void builtin_logger(const LogMessage* msg) {
 namespace impl {
 namespace {
 
+/**
+ * @brief Pushes a message onto the queue, handling overflow.
+ *
+ * @param fill A function to fill in the message, called while the queue entry is owned.
+ */
+template <typename Func>
+void push_message(Func&& fill) {
+    if (!pending_messages.try_push(fill)) {
+        switch (overflow_policy.load(std::memory_order_relaxed)) {
+            case OverflowPolicy::BLOCK:
+                // If a callback logs from the logger thread, nothing else is going to empty the
+                // queue, so blocking would deadlock - drop the message instead
+                if (is_logger_thread) {
+                    dropped_messages.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                while (!pending_messages.try_push(fill)) {
+                    std::this_thread::yield();
+                }
+                break;
+
+            case OverflowPolicy::DROP_OLDEST:
+                // Only ever drop a single old message per push. If there's still no space after
+                // that (e.g. another thread took it first), drop the new message instead - we never
+                // want to spin here, or throw away the entire backlog.
+                if (pending_messages.try_pop([](QueuedLogMessage&) {})) {
+                    dropped_messages.fetch_add(1, std::memory_order_relaxed);
+                    if (pending_messages.try_push(fill)) {
+                        break;
+                    }
+                }
+                dropped_messages.fetch_add(1, std::memory_order_relaxed);
+                return;
+
+            case OverflowPolicy::DROP_NEWEST:
+            default:
+                dropped_messages.fetch_add(1, std::memory_order_relaxed);
+                return;
+        }
+    }
+
+    pending_messages_counter.fetch_add(1);
+    if (logger_sleeping.load()) {
+        pending_messages_counter.notify_one();
+    }
+}
+
 void enqueue_log_msg(uint64_t unix_time_ms,
                      Level level,
                      const char* msg,
@@ -288,11 +613,39 @@ void enqueue_log_msg(uint64_t unix_time_ms,
                      const char* location,
                      size_t location_size,
                      int line) {
-    {
-        const std::lock_guard<std::mutex> lock(pending_messages_mutex);
-        pending_messages.emplace(unix_time_ms, level, msg, msg_size, location, location_size, line);
+    push_message([&](QueuedLogMessage& queued) {
+        queued.assign(unix_time_ms, level, {msg, msg_size}, {location, location_size}, line);
+    });
+}
+
+void enqueue_deferred_log_msg(uint64_t unix_time_ms,
+                              Level level,
+                              const char* fmt,
+                              size_t fmt_size,
+                              deferred_formatter formatter,
+                              const char* args,
+                              size_t args_size,
+                              const char* location,
+                              size_t location_size,
+                              int line) {
+    // If it won't fit, format it now instead
+    if (!QueuedLogMessage::can_defer(location_size, args_size)) {
+        std::string msg{};
+        msg.resize(formatter(fmt, fmt_size, args, nullptr, 0));
+        formatter(fmt, fmt_size, args, msg.data(), msg.size());
+
+        enqueue_log_msg(unix_time_ms, level, msg.data(), msg.size(), location, location_size, line);
+        return;
     }
-    pending_messages_available.notify_all();
+
+    push_message([&](QueuedLogMessage& queued) {
+        queued.assign_deferred(unix_time_ms, level, {fmt, fmt_size}, formatter, {args, args_size},
+                               {location, location_size}, line);
+    });
+}
+
+bool is_enabled(Level level) {
+    return level >= log_level.load(std::memory_order_relaxed);
 }
 
 bool set_console_level(Level level) {
@@ -330,6 +683,23 @@ void init(const std::filesystem::path& file, bool unreal_console) {
     // Start the logger thread first thing
     std::thread(logger_thread).detach();
 
+    auto config_log_level_str = config::get_str("unrealsdk.log_level");
+    if (config_log_level_str.has_value()) {
+        auto config_log_level = get_level_from_string(*config_log_level_str);
+        if (config_log_level != Level::INVALID) {
+            log_level = config_log_level;
+        }
+    }
+
+    auto config_policy = config::get_str("unrealsdk.log_overflow_policy").value_or("");
+    if (config_policy == "block") {
+        overflow_policy = OverflowPolicy::BLOCK;
+    } else if (config_policy == "drop_newest") {
+        overflow_policy = OverflowPolicy::DROP_NEWEST;
+    } else {
+        overflow_policy = OverflowPolicy::DROP_OLDEST;
+    }
+
     if (unreal_console) {
         auto config_level_str = config::get_str("unrealsdk.console_log_level");
         if (config_level_str.has_value()) {
@@ -408,6 +778,62 @@ void log(Level level, std::wstring_view msg, std::string_view location, int line
     (now, level, narrow.data(), narrow.size(), location.data(), location.size(), line);
 }
 
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void,
+               enqueue_deferred_log_msg,
+               uint64_t unix_time_ms,
+               Level level,
+               const char* fmt,
+               size_t fmt_size,
+               impl::deferred_formatter formatter,
+               const char* args,
+               size_t args_size,
+               const char* location,
+               size_t location_size,
+               int line);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void,
+               enqueue_deferred_log_msg,
+               uint64_t unix_time_ms,
+               Level level,
+               const char* fmt,
+               size_t fmt_size,
+               impl::deferred_formatter formatter,
+               const char* args,
+               size_t args_size,
+               const char* location,
+               size_t location_size,
+               int line) {
+    impl::enqueue_deferred_log_msg(unix_time_ms, level, fmt, fmt_size, formatter, args, args_size,
+                                   location, location_size, line);
+}
+#endif
+void impl::log_deferred(Level level,
+                        std::string_view fmt,
+                        deferred_formatter formatter,
+                        const void* args,
+                        size_t args_size,
+                        std::string_view location,
+                        int line) {
+    auto now = unix_ms_now();
+    UNREALSDK_MANGLE(enqueue_deferred_log_msg)
+    (now, level, fmt.data(), fmt.size(), formatter, static_cast<const char*>(args), args_size,
+     location.data(), location.size(), line);
+}
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] bool, log_level_enabled, Level level);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] bool, log_level_enabled, Level level) {
+    return impl::is_enabled(level);
+}
+#endif
+bool is_enabled(Level level) {
+    return UNREALSDK_MANGLE(log_level_enabled)(level);
+}
+
 #ifdef UNREALSDK_SHARED
 UNREALSDK_CAPI(bool, set_console_level, Level level);
 #endif
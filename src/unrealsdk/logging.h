@@ -2,7 +2,12 @@
 #define UNREALSDK_LOGGING_H
 
 // Because this file in included in the pch, we can't include the pch here instead of these
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <format>
+#include <tuple>
+#include <type_traits>
 
 namespace unrealsdk::logging {
 
@@ -58,6 +63,15 @@ void init(const std::filesystem::path& file, bool unreal_console = true);
 void log(Level level, std::string_view msg, std::string_view location, int line);
 void log(Level level, std::wstring_view msg, std::string_view location, int line);
 
+/**
+ * @brief Checks if messages at the given level are logged at all.
+ * @note Controlled by the `unrealsdk.log_level` setting.
+ *
+ * @param level The log level to check.
+ * @return True if messages at this level are logged.
+ */
+[[nodiscard]] bool is_enabled(Level level);
+
 /**
  * @brief Sets the log level of the unreal console.
  * @note Does not affect the log file or external console, if enabled.
@@ -83,17 +97,166 @@ void add_callback(log_callback callback);
  */
 void remove_callback(log_callback callback);
 
+/**
+ * @brief Trait for types which the `LOG` macro may format later, on the logger thread.
+ * @note Types must be trivially copyable, and may not reference memory which may be freed before
+ *       the message gets formatted (so no string pointers or views).
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_deferrable_log_arg
+    : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_null_pointer_v<T>
+                         || std::is_same_v<T, void*> || std::is_same_v<T, const void*>> {};
+
+namespace impl {
+
+/**
+ * @brief Signature of a function which formats a deferred log message.
+ *
+ * @param fmt The format string.
+ * @param fmt_size The size of the format string.
+ * @param args The packed format args.
+ * @param buf The buffer to write the formatted message to.
+ * @param buf_size The size of the buffer.
+ * @return The full size of the formatted message, which may be larger than the buffer.
+ */
+using deferred_formatter = size_t (*)(const char* fmt,
+                                      size_t fmt_size,
+                                      const void* args,
+                                      char* buf,
+                                      size_t buf_size);
+
+// The maximum size of the packed args to try defer formatting for
+constexpr size_t MAX_DEFERRED_ARGS_SIZE = 128;
+
+/*
+Deferred messages store raw pointers to their formatter and format string, both of which live in the
+module which called `LOG`. If that module were unloaded while its messages were still queued, the
+logger thread would call into freed memory.
+
+When importing, the calling module is a different one to that which owns the queue, and we can't
+guarantee it outlives it, so we always format straight away instead.
+*/
+#ifdef UNREALSDK_IMPORTING
+constexpr bool CAN_DEFER_FORMATTING = false;
+#else
+constexpr bool CAN_DEFER_FORMATTING = true;
+#endif
+
+/**
+ * @brief Formats a deferred log message.
+ *
+ * @tparam Args The types of the packed args.
+ */
+template <typename... Args>
+size_t format_deferred(const char* fmt,
+                       size_t fmt_size,
+                       const void* args,
+                       char* buf,
+                       size_t buf_size) {
+    std::tuple<Args...> unpacked{};
+    auto bytes = static_cast<const char*>(args);
+    std::apply(
+        [&bytes](auto&... arg) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            ((std::memcpy(&arg, bytes, sizeof(arg)), bytes += sizeof(arg)), ...);
+        },
+        unpacked);
+
+    auto str = std::apply(
+        [fmt, fmt_size](const auto&... arg) {
+            return std::vformat(std::string_view{fmt, fmt_size}, std::make_format_args(arg...));
+        },
+        unpacked);
+
+    std::copy_n(str.data(), std::min(str.size(), buf_size), buf);
+    return str.size();
+}
+
+/**
+ * @brief Logs a message, deferring formatting it to the logger thread.
+ * @note Should generally use the `LOG()` macro over this.
+ *
+ * @param level The log level.
+ * @param fmt The format string. Must have static lifetime, and outlive the queued message.
+ * @param formatter The function to format the message with. Must outlive the queued message. May
+ *                  throw, in which case a placeholder message is logged instead.
+ * @param args The packed format args.
+ * @param args_size The size of the packed format args.
+ * @param location The location the message was logged from.
+ * @param line The line number the message was logged from.
+ */
+void log_deferred(Level level,
+                  std::string_view fmt,
+                  deferred_formatter formatter,
+                  const void* args,
+                  size_t args_size,
+                  std::string_view location,
+                  int line);
+
+/**
+ * @brief Formats and logs a message.
+ * @note If all args can be deferred, formatting is moved onto the logger thread. This never
+ *       happens when importing, see `CAN_DEFER_FORMATTING`.
+ * @note Should generally use the `LOG()` macro over this.
+ *
+ * @tparam Args The format arg types.
+ * @param level The log level.
+ * @param location The location the message was logged from.
+ * @param line The line number the message was logged from.
+ * @param fmt The format string.
+ * @param args The format args.
+ */
+template <typename... Args>
+void log_format(Level level,
+                std::string_view location,
+                int line,
+                std::format_string<Args...> fmt,
+                Args&&... args) {
+    constexpr size_t args_size = (sizeof(std::remove_cvref_t<Args>) + ... + 0);
+
+    if constexpr (CAN_DEFER_FORMATTING
+                  && (is_deferrable_log_arg<std::remove_cvref_t<Args>>::value && ...)
+                  && args_size <= MAX_DEFERRED_ARGS_SIZE) {
+        std::array<char, std::max<size_t>(args_size, 1)> packed{};
+        auto ptr = packed.data();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ((std::memcpy(ptr, &args, sizeof(args)), ptr += sizeof(args)), ...);
+
+        log_deferred(level, fmt.get(), &format_deferred<std::remove_cvref_t<Args>...>,
+                     packed.data(), args_size, location, line);
+    } else {
+        log(level, std::format(fmt, std::forward<Args>(args)...), location, line);
+    }
+}
+template <typename... Args>
+void log_format(Level level,
+                std::string_view location,
+                int line,
+                std::wformat_string<Args...> fmt,
+                Args&&... args) {
+    log(level, std::format(fmt, std::forward<Args>(args)...), location, line);
+}
+
+}  // namespace impl
+
 }  // namespace unrealsdk::logging
 
 /**
  * @brief Logs a message.
+ * @note The args are only evaluated if the level is enabled.
  *
  * @param level The log level name.
  * @param ... The format string + it's contents.
  */
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
-#define LOG(level, ...)                                                                   \
-    unrealsdk::logging::log((unrealsdk::logging::Level::level), std::format(__VA_ARGS__), \
-                            {(const char*)(__FUNCTION__), sizeof(__FUNCTION__) - 1}, (__LINE__))
+#define LOG(level, ...)                                                             \
+    (unrealsdk::logging::is_enabled(unrealsdk::logging::Level::level)               \
+         ? unrealsdk::logging::impl::log_format((unrealsdk::logging::Level::level), \
+                                                {(const char*)(__FUNCTION__),       \
+                                                 sizeof(__FUNCTION__) - 1},         \
+                                                (__LINE__), __VA_ARGS__)            \
+         : void())
 
 #endif /* UNREALSDK_LOGGING_H */
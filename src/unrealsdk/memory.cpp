@@ -1,6 +1,11 @@
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/config.h"
 #include "unrealsdk/memory.h"
+#include "unrealsdk/pattern_search.h"
+#include "unrealsdk/pe_sections.h"
+#include "unrealsdk/sigscan_cache.h"
+#include "unrealsdk/utils.h"
 
 namespace unrealsdk::memory {
 
@@ -40,35 +45,339 @@ std::pair<uintptr_t, size_t> get_exe_range(void) {
     return *range;
 }
 
-uintptr_t sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
+std::vector<std::pair<uintptr_t, size_t>> get_section_ranges(uintptr_t start,
+                                                             size_t size,
+                                                             Section section) {
+    auto [ranges, fell_back] = impl::find_section_ranges(start, size, section);
+    if (fell_back) {
+        LOG(DEV_WARNING, "Couldn't parse PE headers, falling back to searching entire image");
+    }
+    return ranges;
+}
+
+const std::vector<std::pair<uintptr_t, size_t>>& get_exe_section_ranges(Section section) {
+    static const auto all_ranges = []() {
+        auto [start, size] = get_exe_range();
+
+        std::array<std::vector<std::pair<uintptr_t, size_t>>, 3> ranges{
+            get_section_ranges(start, size, Section::ANY),
+            get_section_ranges(start, size, Section::CODE),
+            get_section_ranges(start, size, Section::DATA),
+        };
+
+        auto total_size = [](const std::vector<std::pair<uintptr_t, size_t>>& section_ranges) {
+            size_t total = 0;
+            for (const auto& [_, range_size] : section_ranges) {
+                total += range_size;
+            }
+            return total;
+        };
+        LOG(MISC, "Executable code sections: {} bytes, data sections: {} bytes",
+            total_size(ranges[(size_t)Section::CODE]), total_size(ranges[(size_t)Section::DATA]));
+
+        return ranges;
+    }();
+
+    return all_ranges.at((size_t)section);
+}
+
+#pragma region Sigscan
+
+namespace {
+
+using impl::find_pattern;
+using impl::NOT_FOUND;
+using impl::PreparedPattern;
+
+const impl::SimdLevel simd_level = impl::detect_simd_level();
+
+/**
+ * @brief Gets the prescan results cache.
+ * @note Must be called with the prescan mutex held.
+ *
+ * @return A reference to the cache.
+ */
+std::unordered_map<const uint8_t*, uintptr_t>& prescan_results(void) {
+    static std::unordered_map<const uint8_t*, uintptr_t> results{};
+    return results;
+}
+
+struct RegisteredPattern {
+    std::string_view name;
+    PatternView pattern;
+};
+
+/**
+ * @brief Gets the list of registered patterns.
+ * @note Must be called with the prescan mutex held.
+ * @note Since patterns are registered during static init, this uses a function static to avoid
+ *       init order issues.
+ *
+ * @return A reference to the list.
+ */
+std::vector<RegisteredPattern>& registered_patterns(void) {
+    static std::vector<RegisteredPattern> patterns{};
+    return patterns;
+}
+
+std::mutex& prescan_mutex(void) {
+    static std::mutex mutex{};
+    return mutex;
+}
+
+using impl::fnv1a;
+using impl::FNV1A_OFFSET_BASIS;
+using impl::hash_pattern;
+using impl::SigscanCache;
+using impl::SigscanCacheStatus;
+
+/**
+ * @brief Hashes the headers of the exe, to identify it.
+ *
+ * @return The hash.
+ */
+uint64_t hash_exe_headers(void) {
     auto [start, size] = get_exe_range();
-    return sigscan(bytes, mask, pattern_size, start, size);
+
+    auto dos_header = reinterpret_cast<IMAGE_DOS_HEADER*>(start);
+    auto nt_header = reinterpret_cast<IMAGE_NT_HEADERS*>(start + dos_header->e_lfanew);
+
+    auto headers_size = std::min<size_t>(nt_header->OptionalHeader.SizeOfHeaders, size);
+    return fnv1a(FNV1A_OFFSET_BASIS, reinterpret_cast<const uint8_t*>(start), headers_size);
+}
+
+/**
+ * @brief Gets the path to the sigscan cache file.
+ *
+ * @return The path, or std::nullopt if caching is disabled.
+ */
+std::optional<std::filesystem::path> get_sigscan_cache_path(void) {
+    auto filename =
+        config::get_str("unrealsdk.sigscan_cache_file").value_or("unrealsdk.sigscan.cache");
+    if (filename.empty()) {
+        return std::nullopt;
+    }
+    return utils::get_this_dll().parent_path() / filename;
+}
+
+/**
+ * @brief Loads the sigscan cache file.
+ *
+ * @param path The path to the cache file.
+ * @param exe_hash The hash of the current exe.
+ * @return A map of pattern hashes to their cached offsets. Empty if the file doesn't exist, is
+ *         invalid, or is for a different exe.
+ */
+SigscanCache load_sigscan_cache(const std::filesystem::path& path, uint64_t exe_hash) {
+    std::ifstream file{path};
+    if (!file.good()) {
+        return {};
+    }
+
+    SigscanCache cache{};
+    switch (impl::read_sigscan_cache(file, exe_hash, cache)) {
+        case SigscanCacheStatus::LOADED:
+            break;
+        case SigscanCacheStatus::UNKNOWN_FORMAT:
+            LOG(DEV_WARNING, "Ignoring sigscan cache with unknown format");
+            break;
+        case SigscanCacheStatus::INVALID:
+            LOG(DEV_WARNING, "Ignoring invalid sigscan cache");
+            break;
+        case SigscanCacheStatus::EXE_CHANGED:
+            LOG(MISC, "Executable changed, ignoring sigscan cache");
+            break;
+    }
+    return cache;
+}
+
+/**
+ * @brief Saves the sigscan cache file.
+ *
+ * @param path The path to the cache file.
+ * @param exe_hash The hash of the current exe.
+ * @param cache A map of pattern hashes to their offsets.
+ */
+void save_sigscan_cache(const std::filesystem::path& path,
+                        uint64_t exe_hash,
+                        const SigscanCache& cache) {
+    std::ofstream file{path, std::ios::trunc};
+    if (!file.good()) {
+        LOG(DEV_WARNING, "Failed to open sigscan cache for writing");
+        return;
+    }
+    impl::write_sigscan_cache(file, exe_hash, cache);
+}
+
+}  // namespace
+
+uintptr_t sigscan(const uint8_t* bytes,
+                  const uint8_t* mask,
+                  size_t pattern_size,
+                  Section section) {
+    {
+        const std::lock_guard<std::mutex> lock(prescan_mutex());
+        auto& results = prescan_results();
+        auto cached = results.find(bytes);
+        if (cached != results.end()) {
+            return cached->second;
+        }
+    }
+
+    for (const auto& [start, size] : get_exe_section_ranges(section)) {
+        auto addr = sigscan(bytes, mask, pattern_size, start, size);
+        if (addr != 0) {
+            return addr;
+        }
+    }
+    return 0;
 }
 uintptr_t sigscan(const uint8_t* bytes,
                   const uint8_t* mask,
                   size_t pattern_size,
                   uintptr_t start,
                   size_t size) {
+    if (size < pattern_size) {
+        return 0;
+    }
+
     auto start_ptr = reinterpret_cast<uint8_t*>(start);
+    auto last = size - pattern_size;
+    const PreparedPattern pattern{bytes, mask, pattern_size};
+
+    auto offset = find_pattern(start_ptr, last, pattern, simd_level);
+    return offset == NOT_FOUND ? 0 : start + offset;
+}
+
+std::vector<uintptr_t> sigscan_batch(std::span<const PatternView> patterns) {
+    std::vector<uintptr_t> results(patterns.size(), 0);
+
+    for (auto section : {Section::ANY, Section::CODE, Section::DATA}) {
+        std::vector<size_t> section_indexes{};
+        std::vector<PatternView> section_patterns{};
+        for (size_t i = 0; i < patterns.size(); i++) {
+            if (patterns[i].section == section) {
+                section_indexes.push_back(i);
+                section_patterns.push_back(patterns[i]);
+            }
+        }
 
-    // The naive O(nm) search works well enough, even repeating it for each different pattern
-    for (size_t i = 0; i < (size - pattern_size); i++) {
-        bool found = true;
-        for (size_t j = 0; j < pattern_size; j++) {
-            auto val = start_ptr[i + j];
-            if ((val & mask[j]) != bytes[j]) {
-                found = false;
+        // Scan each range in turn, only looking for the patterns we haven't found yet
+        for (const auto& [start, size] : get_exe_section_ranges(section)) {
+            if (section_patterns.empty()) {
                 break;
             }
+
+            auto found = sigscan_batch(section_patterns, start, size);
+
+            std::vector<size_t> remaining_indexes{};
+            std::vector<PatternView> remaining_patterns{};
+            for (size_t i = 0; i < found.size(); i++) {
+                if (found[i] != 0) {
+                    results[section_indexes[i]] = found[i];
+                } else {
+                    remaining_indexes.push_back(section_indexes[i]);
+                    remaining_patterns.push_back(section_patterns[i]);
+                }
+            }
+            section_indexes = std::move(remaining_indexes);
+            section_patterns = std::move(remaining_patterns);
         }
-        if (found) {
-            return reinterpret_cast<uintptr_t>(&start_ptr[i]);
+    }
+
+    return results;
+}
+std::vector<uintptr_t> sigscan_batch(std::span<const PatternView> patterns,
+                                     uintptr_t start,
+                                     size_t size) {
+    auto offsets = impl::find_patterns_batch(reinterpret_cast<uint8_t*>(start), size, patterns,
+                                             simd_level);
+
+    std::vector<uintptr_t> results(patterns.size(), 0);
+    for (size_t i = 0; i < patterns.size(); i++) {
+        if (offsets[i] != NOT_FOUND) {
+            results[i] = start + offsets[i];
         }
     }
+    return results;
+}
 
-    return 0;
+void register_pattern(std::string_view name, const PatternView& pattern) {
+    const std::lock_guard<std::mutex> lock(prescan_mutex());
+    registered_patterns().push_back({.name = name, .pattern = pattern});
+}
+
+void prescan(bool cache_misses) {
+    const std::lock_guard<std::mutex> lock(prescan_mutex());
+    const auto& registered = registered_patterns();
+    auto [start, size] = get_exe_range();
+
+    auto cache_path = get_sigscan_cache_path();
+    auto exe_hash = hash_exe_headers();
+    SigscanCache cache{};
+    if (cache_path.has_value()) {
+        cache = load_sigscan_cache(*cache_path, exe_hash);
+    }
+
+    std::vector<PatternView> patterns{};
+    std::vector<uint64_t> pattern_hashes{};
+    patterns.reserve(registered.size());
+    pattern_hashes.reserve(registered.size());
+    for (const auto& pattern : registered) {
+        patterns.push_back(pattern.pattern);
+        pattern_hashes.push_back(hash_pattern(pattern.pattern));
+    }
+
+    std::vector<uintptr_t> found(registered.size(), 0);
+    auto to_scan =
+        impl::resolve_from_sigscan_cache(patterns, pattern_hashes, cache, start, size, found);
+
+    if (!to_scan.empty()) {
+        std::vector<PatternView> to_scan_patterns{};
+        to_scan_patterns.reserve(to_scan.size());
+        for (auto idx : to_scan) {
+            to_scan_patterns.push_back(patterns[idx]);
+        }
+
+        auto scanned = sigscan_batch(to_scan_patterns);
+        for (size_t i = 0; i < to_scan.size(); i++) {
+            found[to_scan[i]] = scanned[i];
+        }
+
+        if (cache_path.has_value()) {
+            auto new_cache =
+                impl::build_sigscan_cache(pattern_hashes, found, cache, start, cache_misses);
+
+            // If we couldn't cache misses, we'll rescan for them every launch, but if none of them
+            // turned up there's no need to rewrite the file
+            if (new_cache != cache) {
+                save_sigscan_cache(*cache_path, exe_hash, new_cache);
+            }
+        }
+    }
+
+    // Patterns for other games may be registered too, so don't warn about failures here, leave that
+    // to whoever actually tries to use the pattern
+    auto& results = prescan_results();
+    size_t num_found = 0;
+    for (size_t i = 0; i < registered.size(); i++) {
+        results[registered[i].pattern.bytes] = found[i];
+        if (found[i] != 0) {
+            num_found++;
+        }
+    }
+
+    LOG(MISC, "Prescan found {}/{} patterns ({} from cache)", num_found, registered.size(),
+        registered.size() - to_scan.size());
 }
 
+void clear_prescan(void) {
+    const std::lock_guard<std::mutex> lock(prescan_mutex());
+    prescan_results().clear();
+}
+
+#pragma endregion
+
 #ifdef UNREALSDK_SHARED
 UNREALSDK_CAPI(bool,
                detour,
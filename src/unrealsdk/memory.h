@@ -3,11 +3,36 @@
 
 #include "unrealsdk/pch.h"
 
+// Defines `Section` and `PatternView`
+#include "unrealsdk/pattern_search.h"
+
 namespace unrealsdk::memory {
 
 template <size_t n>
 struct Pattern;
 
+/**
+ * @brief Parses the section table of a PE image, to find the address ranges covered by a section.
+ * @note Adjacent sections are merged into a single range.
+ * @note If the headers are invalid, falls back to returning the entire image.
+ *
+ * @param start The start of the image, as loaded in memory.
+ * @param size The size of the image.
+ * @param section The section to find.
+ * @return A list of pairs of the start address and length of each range.
+ */
+std::vector<std::pair<uintptr_t, size_t>> get_section_ranges(uintptr_t start,
+                                                             size_t size,
+                                                             Section section);
+
+/**
+ * @brief Gets the address ranges covered by a section of the exe's module.
+ *
+ * @param section The section to find.
+ * @return A list of pairs of the start address and length of each range.
+ */
+const std::vector<std::pair<uintptr_t, size_t>>& get_exe_section_ranges(Section section);
+
 /**
  * @brief Performs a sigscan.
  *
@@ -15,19 +40,26 @@ struct Pattern;
  * @param bytes The bytes to search for.
  * @param mask The mask over the bytes to search for.
  * @param pattern_size The size of the bytes + mask.
- * @param start The address to start the search at. Defaults to the start of the exe.
- * @param size The length of the region to search. Defaults to the exe size
+ * @param section The sections of the exe to search through. Defaults to the entire exe.
+ * @param start The address to start the search at. Overrides searching through sections.
+ * @param size The length of the region to search.
  * @return The found location, or nullptr.
  */
-uintptr_t sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size);
+uintptr_t sigscan(const uint8_t* bytes,
+                  const uint8_t* mask,
+                  size_t pattern_size,
+                  Section section = Section::ANY);
 uintptr_t sigscan(const uint8_t* bytes,
                   const uint8_t* mask,
                   size_t pattern_size,
                   uintptr_t start,
                   size_t size);
 template <typename T>
-T sigscan(const uint8_t* bytes, const uint8_t* mask, size_t pattern_size) {
-    return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size));
+T sigscan(const uint8_t* bytes,
+          const uint8_t* mask,
+          size_t pattern_size,
+          Section section = Section::ANY) {
+    return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size, section));
 }
 template <typename T>
 T sigscan(const uint8_t* bytes,
@@ -38,6 +70,48 @@ T sigscan(const uint8_t* bytes,
     return reinterpret_cast<T>(sigscan(bytes, mask, pattern_size, start, size));
 }
 
+/**
+ * @brief Performs a batch of sigscans, in a single pass over memory.
+ * @note Unlike calling `sigscan` repeatedly, this only needs to read through memory once, no matter
+ *       how many patterns there are. The work is also split across multiple threads.
+ *
+ * @param patterns The patterns to search for.
+ * @param start The address to start the search at. Overrides searching through each pattern's
+ *              sections.
+ * @param size The length of the region to search.
+ * @return A list of the found location of each pattern, in the same order, or nullptr.
+ */
+std::vector<uintptr_t> sigscan_batch(std::span<const PatternView> patterns);
+std::vector<uintptr_t> sigscan_batch(std::span<const PatternView> patterns,
+                                     uintptr_t start,
+                                     size_t size);
+
+/**
+ * @brief Registers a pattern to be included in the batch run by `prescan`.
+ * @note Typically called via a `PatternRegistration`, at static init time.
+ *
+ * @param name The name of the pattern, to use in log messages.
+ * @param pattern The pattern. Must have static lifetime.
+ */
+void register_pattern(std::string_view name, const PatternView& pattern);
+
+/**
+ * @brief Sigscans for all registered patterns in a single batch, caching the results.
+ * @note While cached, sigscans for a registered pattern across the exe return the cached result.
+ * @note Since the cached results go stale if the exe is modified, they should be cleared using
+ *       `clear_prescan` once the bulk of the sigscans are done, before making any hex edits.
+ *
+ * @param cache_misses True if the exe is known to be in its final state (e.g. after any DRM has
+ *                     unpacked it), so patterns which weren't found can be cached on disk, and
+ *                     skipped on future launches.
+ */
+void prescan(bool cache_misses = true);
+
+/**
+ * @brief Clears all results cached by `prescan`.
+ */
+void clear_prescan(void);
+
 /**
  * @brief Detours a function.
  *
@@ -107,6 +181,8 @@ struct Pattern {
     std::array<uint8_t, n> mask;
     /// A constant offset to add to the found address.
     ptrdiff_t offset = 0;
+    /// The sections of the exe to search through.
+    Section section = Section::CODE;
 
     /**
      * @brief Construct a pattern.
@@ -114,14 +190,22 @@ struct Pattern {
      * @param bytes The bytes to match.
      * @param mask The mask over the bytes to match.
      * @param offset The constant offset to add to the found address.
+     * @param section The sections of the exe to search through.
      * @return A sigscan pattern.
      */
-    Pattern(const uint8_t (&bytes)[n], const uint8_t (&mask)[n], ptrdiff_t offset = 0)
-        : bytes(bytes), mask(mask), offset(offset) {}
-    Pattern(const char (&bytes)[n + 1], const char (&mask)[n + 1], ptrdiff_t offset = 0)
+    Pattern(const uint8_t (&bytes)[n],
+            const uint8_t (&mask)[n],
+            ptrdiff_t offset = 0,
+            Section section = Section::CODE)
+        : bytes(bytes), mask(mask), offset(offset), section(section) {}
+    Pattern(const char (&bytes)[n + 1],
+            const char (&mask)[n + 1],
+            ptrdiff_t offset = 0,
+            Section section = Section::CODE)
         : bytes(reinterpret_cast<const uint8_t*>(bytes)),
           mask(reinterpret_cast<const uint8_t*>(mask)),
-          offset(offset) {
+          offset(offset),
+          section(section) {
         static_assert(sizeof(uint8_t) == sizeof(char), "uint8_t is different size to char");
     }
 
@@ -158,12 +242,14 @@ struct Pattern {
      * @tparam m The size of the passed hex string - should be picked up automatically.
      * @param hex The hex string to convert.
      * @param offset The constant offset to add to the found address.
+     * @param section The sections of the exe to search through.
      * @return A sigscan pattern.
      */
     template <size_t m>
     consteval Pattern(const char (&hex)[m],
-                      ptrdiff_t offset = std::numeric_limits<ptrdiff_t>::max())
-        : bytes(), mask(), offset(offset) {
+                      ptrdiff_t offset = std::numeric_limits<ptrdiff_t>::max(),
+                      Section section = Section::CODE)
+        : bytes(), mask(), offset(offset), section(section) {
         size_t idx = 0;
         bool upper_nibble = true;
 
@@ -209,9 +295,12 @@ struct Pattern {
             this->offset = 0;
         }
     }
+    template <size_t m>
+    consteval Pattern(const char (&hex)[m], Section section)
+        : Pattern(hex, std::numeric_limits<ptrdiff_t>::max(), section) {}
 
     /**
-     * @brief Performs a sigscan for this pattern across the main executable.
+     * @brief Performs a sigscan for this pattern across the relevant sections of the executable.
      * @note When not found, `sigscan` throws, while `sigscan_nullable` returns 0.
      *
      * @tparam T The type to cast the result to.
@@ -219,7 +308,7 @@ struct Pattern {
      * @return The found location, or 0.
      */
     [[nodiscard]] uintptr_t sigscan(std::string_view name) const {
-        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n);
+        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n, this->section);
         if (addr == 0) {
             // Make sure to log something on error, even if calling code doesn't catch it
             LOG(ERROR, "Sigscan for {} failed!", name);
@@ -232,7 +321,7 @@ struct Pattern {
         return reinterpret_cast<T>(this->sigscan(name));
     }
     [[nodiscard]] uintptr_t sigscan_nullable(void) const {
-        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n);
+        auto addr = memory::sigscan(this->bytes.data(), this->mask.data(), n, this->section);
         return addr == 0 ? 0 : addr + offset;
     }
     template <typename T>
@@ -241,6 +330,27 @@ struct Pattern {
     }
 };
 
+/**
+ * @brief Helper which registers a pattern to be included in the prescan batch.
+ * @note Intended to be defined at namespace scope, next to the pattern it registers.
+ */
+struct PatternRegistration {
+    /**
+     * @brief Registers a pattern.
+     *
+     * @tparam n The size of the pattern (should be picked up automatically).
+     * @param name The name of the pattern, to use in log messages.
+     * @param pattern The pattern to register. Must have static lifetime.
+     */
+    template <size_t n>
+    PatternRegistration(std::string_view name, const Pattern<n>& pattern) {
+        register_pattern(name, {.bytes = pattern.bytes.data(),
+                                .mask = pattern.mask.data(),
+                                .size = n,
+                                .section = pattern.section});
+    }
+};
+
 /**
  * @brief Gets the address range covered by the exe's module.
  *
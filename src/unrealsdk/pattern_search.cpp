@@ -0,0 +1,369 @@
+// Deliberately not using the pch, see the header
+#include "unrealsdk/pattern_search.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <thread>
+#include <vector>
+
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+namespace unrealsdk::memory::impl {
+
+namespace {
+
+// The minimum amount of bytes to give each thread during a batch search
+const constexpr size_t MIN_BATCH_BYTES_PER_THREAD = 1024 * 1024;
+// How many candidates to check for every pattern at once during a SIMD batch search. Small enough
+// that the chunk stays in L1/L2 while we go through all the patterns.
+const constexpr size_t BATCH_CHUNK_SIZE = 32 * 1024;
+
+}  // namespace
+
+#if defined(__clang__) || defined(__GNUC__)
+#define UNREALSDK_TARGET(features) __attribute__((target(features)))
+#else
+#define UNREALSDK_TARGET(features)
+#endif
+
+UNREALSDK_TARGET("xsave")
+SimdLevel detect_simd_level(void) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    std::array<uint32_t, 4> regs{};
+    auto cpuid = [&regs](uint32_t leaf, uint32_t subleaf) {
+#ifdef _MSC_VER
+        std::array<int, 4> signed_regs{};
+        __cpuidex(signed_regs.data(), static_cast<int>(leaf), static_cast<int>(subleaf));
+        std::ranges::transform(signed_regs, regs.begin(),
+                               [](int val) { return static_cast<uint32_t>(val); });
+#else
+        __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    };
+
+    cpuid(0, 0);
+    auto max_leaf = regs[0];
+    if (max_leaf < 1) {
+        return SimdLevel::SCALAR;
+    }
+
+    cpuid(1, 0);
+    const bool sse2 = (regs[3] & (1 << 26)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!sse2) {
+        return SimdLevel::SCALAR;
+    }
+
+    // AVX2 requires both CPU support, and for the OS to save the upper halves of the registers
+    if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0b110) == 0b110) {
+        cpuid(7, 0);
+        if ((regs[1] & (1 << 5)) != 0) {
+            return SimdLevel::AVX2;
+        }
+    }
+
+    return SimdLevel::SSE2;
+    // NOLINTEND(readability-magic-numbers)
+}
+
+size_t find_pattern_scalar(const uint8_t* start,
+                           size_t first,
+                           size_t last,
+                           const PreparedPattern& pattern) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (auto i = first; i <= last; i++) {
+        if (pattern.has_anchor
+            && start[i + pattern.first_anchor] != pattern.bytes[pattern.first_anchor]) {
+            continue;
+        }
+        if (pattern.matches_at(start + i)) {
+            return i;
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return NOT_FOUND;
+}
+
+UNREALSDK_TARGET("sse2")
+size_t find_pattern_sse2(const uint8_t* start, size_t last, const PreparedPattern& pattern) {
+    const constexpr size_t width = sizeof(__m128i);
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //             cppcoreguidelines-pro-type-reinterpret-cast)
+    auto first_anchor = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_anchor]));
+    auto second_anchor = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.second_anchor]));
+
+    // Since the anchors are within the pattern, as long as all candidates are valid, all loads are
+    // in bounds
+    size_t i = 0;
+    for (; i + width <= last + 1; i += width) {
+        auto first_block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i + pattern.first_anchor));
+        auto second_block =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(start + i + pattern.second_anchor));
+
+        auto candidates = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_block, first_anchor),
+                                            _mm_cmpeq_epi8(second_block, second_anchor))));
+
+        while (candidates != 0) {
+            auto offset = i + std::countr_zero(candidates);
+            if (pattern.matches_at(start + offset)) {
+                return offset;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //           cppcoreguidelines-pro-type-reinterpret-cast)
+
+    return i <= last ? find_pattern_scalar(start, i, last, pattern) : NOT_FOUND;
+}
+
+UNREALSDK_TARGET("avx2")
+size_t find_pattern_avx2(const uint8_t* start, size_t last, const PreparedPattern& pattern) {
+    const constexpr size_t width = sizeof(__m256i);
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //             cppcoreguidelines-pro-type-reinterpret-cast)
+    auto first_anchor = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_anchor]));
+    auto second_anchor =
+        _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.second_anchor]));
+
+    size_t i = 0;
+    for (; i + width <= last + 1; i += width) {
+        auto first_block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(start + i + pattern.first_anchor));
+        auto second_block =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(start + i + pattern.second_anchor));
+
+        auto candidates = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first_block, first_anchor),
+                             _mm256_cmpeq_epi8(second_block, second_anchor))));
+
+        while (candidates != 0) {
+            auto offset = i + std::countr_zero(candidates);
+            if (pattern.matches_at(start + offset)) {
+                return offset;
+            }
+            candidates &= candidates - 1;
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //           cppcoreguidelines-pro-type-reinterpret-cast)
+
+    return i <= last ? find_pattern_scalar(start, i, last, pattern) : NOT_FOUND;
+}
+
+size_t find_pattern(const uint8_t* start,
+                    size_t last,
+                    const PreparedPattern& pattern,
+                    SimdLevel level) {
+    if (!pattern.has_anchor) {
+        return find_pattern_scalar(start, 0, last, pattern);
+    }
+
+    switch (level) {
+        case SimdLevel::AVX2:
+            return find_pattern_avx2(start, last, pattern);
+        case SimdLevel::SSE2:
+            return find_pattern_sse2(start, last, pattern);
+        case SimdLevel::SCALAR:
+        default:
+            return find_pattern_scalar(start, 0, last, pattern);
+    }
+}
+
+namespace {
+
+using Buckets = std::array<std::vector<size_t>, std::numeric_limits<uint8_t>::max() + 1>;
+
+/**
+ * @brief Scans a range for a batch of patterns, by walking memory a byte at a time and checking the
+ *        patterns whose first anchor matches.
+ * @note Ranges are split by anchor address.
+ *
+ * @param start The start of the region to search.
+ * @param size The size of the region to search.
+ * @param prepared The prepared patterns.
+ * @param buckets The indexes of the patterns to check, bucketed by their first anchor byte.
+ * @param range_start The first anchor address to check.
+ * @param range_end The anchor address to stop at, exclusive.
+ * @param found The offsets each pattern was found at. Only patterns not yet found are checked.
+ */
+void scan_range_bucketed(const uint8_t* start,
+                         size_t size,
+                         std::span<const PreparedPattern> prepared,
+                         const Buckets& buckets,
+                         size_t range_start,
+                         size_t range_end,
+                         std::vector<size_t>& found) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //             cppcoreguidelines-pro-bounds-constant-array-index)
+    for (auto anchor_addr = range_start; anchor_addr < range_end; anchor_addr++) {
+        const auto& bucket = buckets[start[anchor_addr]];
+        for (auto pattern_idx : bucket) {
+            const auto& pattern = prepared[pattern_idx];
+            if (found[pattern_idx] != NOT_FOUND || anchor_addr < pattern.first_anchor) {
+                continue;
+            }
+
+            auto candidate = anchor_addr - pattern.first_anchor;
+            if (candidate > size - pattern.size) {
+                continue;
+            }
+            if (start[candidate + pattern.second_anchor] == pattern.bytes[pattern.second_anchor]
+                && pattern.matches_at(start + candidate)) {
+                found[pattern_idx] = candidate;
+            }
+        }
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic,
+    //           cppcoreguidelines-pro-bounds-constant-array-index)
+}
+
+/**
+ * @brief Scans a range for a batch of patterns, by running the SIMD search for every pattern over
+ *        one small chunk at a time.
+ * @note Ranges are split by candidate offset.
+ *
+ * @param start The start of the region to search.
+ * @param size The size of the region to search.
+ * @param prepared The prepared patterns.
+ * @param level The SIMD level to use.
+ * @param range_start The first candidate offset to check.
+ * @param range_end The candidate offset to stop at, exclusive.
+ * @param found The offsets each pattern was found at. Only patterns not yet found are checked.
+ */
+void scan_range_chunked(const uint8_t* start,
+                        size_t size,
+                        std::span<const PreparedPattern> prepared,
+                        SimdLevel level,
+                        size_t range_start,
+                        size_t range_end,
+                        std::vector<size_t>& found) {
+    std::vector<size_t> pending{};
+    for (size_t i = 0; i < prepared.size(); i++) {
+        if (found[i] == NOT_FOUND && prepared[i].size <= size) {
+            pending.push_back(i);
+        }
+    }
+
+    for (auto chunk_start = range_start; chunk_start < range_end && !pending.empty();
+         chunk_start += BATCH_CHUNK_SIZE) {
+        auto chunk_end = std::min(range_end, chunk_start + BATCH_CHUNK_SIZE);
+
+        std::erase_if(pending, [&](size_t pattern_idx) {
+            const auto& pattern = prepared[pattern_idx];
+            auto last_candidate = size - pattern.size;
+            if (chunk_start > last_candidate) {
+                return true;
+            }
+
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto offset = find_pattern(start + chunk_start,
+                                       std::min(chunk_end - 1, last_candidate) - chunk_start,
+                                       pattern, level);
+            if (offset == NOT_FOUND) {
+                return false;
+            }
+            found[pattern_idx] = chunk_start + offset;
+            return true;
+        });
+    }
+}
+
+}  // namespace
+
+std::vector<size_t> find_patterns_batch(const uint8_t* start,
+                                        size_t size,
+                                        std::span<const PatternView> patterns,
+                                        SimdLevel level) {
+    std::vector<size_t> results(patterns.size(), NOT_FOUND);
+
+    /*
+    With SIMD, a single pattern scan is fast enough that we're mostly limited by memory bandwidth,
+    so scanning for each pattern separately means pulling the entire range through the cache once
+    per pattern. Instead, we split memory into small chunks, and run every pattern's scan over each
+    chunk while it's still in cache. Patterns drop out as soon as they're found.
+
+    Without SIMD, checking each position one pattern at a time is far too slow. Instead, we bucket
+    the patterns by the value of their first anchor byte, walk through memory once, and at each
+    address only check the patterns whose anchor matches the byte there. Patterns without an anchor
+    can't be bucketed, they get scanned separately.
+    */
+    std::vector<PreparedPattern> prepared{};
+    prepared.reserve(patterns.size());
+    for (const auto& pattern : patterns) {
+        prepared.emplace_back(pattern.bytes, pattern.mask, pattern.size);
+    }
+
+    Buckets buckets{};
+    if (level == SimdLevel::SCALAR) {
+        for (size_t i = 0; i < prepared.size(); i++) {
+            const auto& pattern = prepared[i];
+            if (size < pattern.size) {
+                continue;
+            }
+
+            if (pattern.has_anchor) {
+                buckets[pattern.bytes[pattern.first_anchor]].push_back(i);
+            } else {
+                results[i] = find_pattern_scalar(start, 0, size - pattern.size, pattern);
+            }
+        }
+    }
+
+    /*
+    Split memory between threads. Since each pattern has a fixed anchor offset, splitting on either
+    the anchor address or the candidate offset splits the candidates without any overlap.
+
+    Each thread only finds the first match for each pattern within its own range, so we can then
+    just take the first thread which found a match.
+    */
+    auto num_threads = std::clamp<size_t>(size / MIN_BATCH_BYTES_PER_THREAD, 1,
+                                          std::max(std::thread::hardware_concurrency(), 1U));
+    auto bytes_per_thread = (size + num_threads - 1) / num_threads;
+    std::vector<std::vector<size_t>> thread_results(num_threads, results);
+
+    auto worker = [&](size_t thread_idx) {
+        auto range_start = thread_idx * bytes_per_thread;
+        auto range_end = std::min(size, range_start + bytes_per_thread);
+        if (level == SimdLevel::SCALAR) {
+            scan_range_bucketed(start, size, prepared, buckets, range_start, range_end,
+                                thread_results[thread_idx]);
+        } else {
+            scan_range_chunked(start, size, prepared, level, range_start, range_end,
+                               thread_results[thread_idx]);
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads{};
+        threads.reserve(num_threads - 1);
+        for (size_t i = 1; i < num_threads; i++) {
+            threads.emplace_back(worker, i);
+        }
+        worker(0);
+    }
+
+    for (size_t i = 0; i < patterns.size(); i++) {
+        for (const auto& found : thread_results) {
+            if (found[i] != NOT_FOUND) {
+                results[i] = found[i];
+                break;
+            }
+        }
+    }
+
+    return results;
+}
+
+}  // namespace unrealsdk::memory::impl
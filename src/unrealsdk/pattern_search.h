@@ -0,0 +1,181 @@
+#ifndef UNREALSDK_PATTERN_SEARCH_H
+#define UNREALSDK_PATTERN_SEARCH_H
+
+// This file (and its implementation) deliberately doesn't rely on the pch, or on anything Windows
+// specific, so that it can also be built natively by the tests.
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace unrealsdk::memory {
+
+/// The sections of the exe a sigscan may search through.
+enum class Section : uint8_t {
+    /// The entire exe, including headers.
+    ANY,
+    /// Executable sections, e.g. `.text`.
+    CODE,
+    /// Non-executable sections holding initialized data, e.g. `.rdata` or `.data`.
+    DATA,
+};
+
+/// A type erased view of a sigscan pattern.
+struct PatternView {
+    /// The bytes to match.
+    const uint8_t* bytes;
+    /// The mask over the bytes to match.
+    const uint8_t* mask;
+    /// The size of the bytes + mask.
+    size_t size;
+    /// The sections of the exe to search through.
+    Section section = Section::ANY;
+};
+
+}  // namespace unrealsdk::memory
+
+namespace unrealsdk::memory::impl {
+
+/*
+Sigscans are a large portion of our startup time, we run dozens of them, each over the entire exe.
+
+To speed them up, we pick two "anchor" bytes out of the pattern, which are fully unmasked. Using
+SIMD, we can then check 16/32 candidate positions at once, by checking if both anchors match. Only
+the (relatively few) positions which pass this filter are then checked against the full pattern.
+
+If the pattern doesn't have any fully unmasked bytes, we just fall back to a simple scalar search.
+*/
+
+const constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+struct PreparedPattern {
+    const uint8_t* bytes;
+    const uint8_t* mask;
+    size_t size;
+
+    // The offsets of the two anchor bytes - may be the same byte if there's only one
+    bool has_anchor;
+    size_t first_anchor;
+    size_t second_anchor;
+
+    PreparedPattern(const uint8_t* bytes, const uint8_t* mask, size_t size)
+        : bytes(bytes),
+          mask(mask),
+          size(size),
+          has_anchor(false),
+          first_anchor(0),
+          second_anchor(0) {
+        // Pick the first and last fully unmasked bytes, since they're the most likely to differ
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (size_t i = 0; i < size; i++) {
+            if (mask[i] != std::numeric_limits<uint8_t>::max()) {
+                continue;
+            }
+            if (!this->has_anchor) {
+                this->has_anchor = true;
+                this->first_anchor = i;
+            }
+            this->second_anchor = i;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Checks if this pattern matches at the given address.
+     *
+     * @param ptr The address to check.
+     * @return True if the pattern matches.
+     */
+    [[nodiscard]] bool matches_at(const uint8_t* ptr) const {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        for (size_t i = 0; i < this->size; i++) {
+            if ((ptr[i] & this->mask[i]) != this->bytes[i]) {
+                return false;
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return true;
+    }
+};
+
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    SSE2,
+    AVX2,
+};
+
+/**
+ * @brief Checks what SIMD instructions the current CPU supports.
+ *
+ * @return The best supported SIMD level.
+ */
+SimdLevel detect_simd_level(void);
+
+/**
+ * @brief Searches for a pattern, without using any SIMD.
+ *
+ * @param start The start of the region to search.
+ * @param first The first candidate offset to check.
+ * @param last The last candidate offset to check, inclusive.
+ * @param pattern The pattern to search for.
+ * @return The offset the pattern was found at, or NOT_FOUND.
+ */
+size_t find_pattern_scalar(const uint8_t* start,
+                           size_t first,
+                           size_t last,
+                           const PreparedPattern& pattern);
+
+/**
+ * @brief Searches for a pattern, using SSE2 to filter candidates.
+ * @note Requires the pattern to have an anchor, and the CPU to support SSE2.
+ *
+ * @param start The start of the region to search.
+ * @param last The last candidate offset to check, inclusive.
+ * @param pattern The pattern to search for.
+ * @return The offset the pattern was found at, or NOT_FOUND.
+ */
+size_t find_pattern_sse2(const uint8_t* start, size_t last, const PreparedPattern& pattern);
+
+/**
+ * @brief Searches for a pattern, using AVX2 to filter candidates.
+ * @note Requires the pattern to have an anchor, and the CPU to support AVX2.
+ *
+ * @param start The start of the region to search.
+ * @param last The last candidate offset to check, inclusive.
+ * @param pattern The pattern to search for.
+ * @return The offset the pattern was found at, or NOT_FOUND.
+ */
+size_t find_pattern_avx2(const uint8_t* start, size_t last, const PreparedPattern& pattern);
+
+/**
+ * @brief Searches for a pattern, picking the best implementation for it.
+ *
+ * @param start The start of the region to search.
+ * @param last The last candidate offset to check, inclusive.
+ * @param pattern The pattern to search for.
+ * @param level The SIMD level to use. Must be supported by the CPU.
+ * @return The offset the pattern was found at, or NOT_FOUND.
+ */
+size_t find_pattern(const uint8_t* start,
+                    size_t last,
+                    const PreparedPattern& pattern,
+                    SimdLevel level);
+
+/**
+ * @brief Searches for a batch of patterns, in a single multithreaded pass over memory.
+ *
+ * @param start The start of the region to search.
+ * @param size The size of the region to search.
+ * @param patterns The patterns to search for. Their sections are ignored.
+ * @param level The SIMD level to use. Must be supported by the CPU.
+ * @return The offset each pattern was found at, in the same order, or NOT_FOUND.
+ */
+std::vector<size_t> find_patterns_batch(const uint8_t* start,
+                                        size_t size,
+                                        std::span<const PatternView> patterns,
+                                        SimdLevel level);
+
+}  // namespace unrealsdk::memory::impl
+
+#endif /* UNREALSDK_PATTERN_SEARCH_H */
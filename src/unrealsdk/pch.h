@@ -37,6 +37,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
 #include <cctype>
 #include <charconv>
 #include <chrono>
@@ -56,6 +57,8 @@
 #include <optional>
 #include <queue>
 #include <ranges>
+#include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -0,0 +1,115 @@
+// Deliberately not using the pch, see the header
+#include "unrealsdk/pe_sections.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace unrealsdk::memory::impl {
+
+namespace {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+// The relevant parts of the PE format, see `IMAGE_DOS_HEADER`, `IMAGE_NT_HEADERS`, and
+// `IMAGE_SECTION_HEADER` in `winnt.h`
+
+const constexpr uint16_t DOS_SIGNATURE = 0x5A4D;  // "MZ"
+const constexpr size_t DOS_HEADER_SIZE = 0x40;
+const constexpr size_t DOS_E_LFANEW_OFFSET = 0x3C;
+
+const constexpr uint32_t NT_SIGNATURE = 0x00004550;  // "PE\0\0"
+const constexpr size_t NT_NUMBER_OF_SECTIONS_OFFSET = 0x06;
+const constexpr size_t NT_SIZE_OF_OPTIONAL_HEADER_OFFSET = 0x14;
+const constexpr size_t NT_OPTIONAL_HEADER_OFFSET = 0x18;
+
+const constexpr size_t SECTION_HEADER_SIZE = 0x28;
+const constexpr size_t SECTION_VIRTUAL_SIZE_OFFSET = 0x08;
+const constexpr size_t SECTION_VIRTUAL_ADDRESS_OFFSET = 0x0C;
+const constexpr size_t SECTION_SIZE_OF_RAW_DATA_OFFSET = 0x10;
+const constexpr size_t SECTION_CHARACTERISTICS_OFFSET = 0x24;
+
+const constexpr uint32_t SCN_CNT_INITIALIZED_DATA = 0x00000040;
+const constexpr uint32_t SCN_MEM_EXECUTE = 0x20000000;
+
+// NOLINTEND(readability-magic-numbers)
+
+/**
+ * @brief Reads a little endian integer out of the image.
+ * @note Does not bounds check.
+ *
+ * @tparam T The type of integer to read.
+ * @param start The start of the image.
+ * @param offset The offset to read at.
+ * @return The read value.
+ */
+template <typename T>
+T read(uintptr_t start, size_t offset) {
+    T value{};
+    // NOLINTNEXTLINE(performance-no-int-to-ptr)
+    memcpy(&value, reinterpret_cast<const void*>(start + offset), sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+SectionRanges find_section_ranges(uintptr_t start, size_t size, Section section) {
+    const SectionRanges whole_image{.ranges = {{start, size}}, .fell_back = true};
+    if (section == Section::ANY) {
+        return {.ranges = {{start, size}}, .fell_back = false};
+    }
+
+    if (size < DOS_HEADER_SIZE || read<uint16_t>(start, 0) != DOS_SIGNATURE) {
+        return whole_image;
+    }
+    auto nt_offset = read<int32_t>(start, DOS_E_LFANEW_OFFSET);
+    if (nt_offset < 0 || size - NT_OPTIONAL_HEADER_OFFSET < static_cast<size_t>(nt_offset)
+        || read<uint32_t>(start, nt_offset) != NT_SIGNATURE) {
+        return whole_image;
+    }
+
+    auto num_sections = read<uint16_t>(start, nt_offset + NT_NUMBER_OF_SECTIONS_OFFSET);
+    auto section_table_offset =
+        static_cast<size_t>(nt_offset) + NT_OPTIONAL_HEADER_OFFSET
+        + read<uint16_t>(start, nt_offset + NT_SIZE_OF_OPTIONAL_HEADER_OFFSET);
+    if (section_table_offset > size
+        || (size - section_table_offset) / SECTION_HEADER_SIZE < num_sections) {
+        return whole_image;
+    }
+
+    SectionRanges found{.ranges = {}, .fell_back = false};
+    for (size_t i = 0; i < num_sections; i++) {
+        auto header = section_table_offset + (i * SECTION_HEADER_SIZE);
+        auto characteristics = read<uint32_t>(start, header + SECTION_CHARACTERISTICS_OFFSET);
+        auto virtual_address = read<uint32_t>(start, header + SECTION_VIRTUAL_ADDRESS_OFFSET);
+
+        auto executable = (characteristics & SCN_MEM_EXECUTE) != 0;
+        auto matches = section == Section::CODE
+                           ? executable
+                           : !executable && (characteristics & SCN_CNT_INITIALIZED_DATA) != 0;
+        if (!matches || virtual_address >= size) {
+            continue;
+        }
+
+        // The virtual size is not always filled in, in which case we can use the raw size instead
+        size_t section_size = read<uint32_t>(start, header + SECTION_VIRTUAL_SIZE_OFFSET);
+        if (section_size == 0) {
+            section_size = read<uint32_t>(start, header + SECTION_SIZE_OF_RAW_DATA_OFFSET);
+        }
+        section_size = std::min<size_t>(section_size, size - virtual_address);
+        if (section_size == 0) {
+            continue;
+        }
+
+        auto section_start = start + virtual_address;
+        auto& ranges = found.ranges;
+        if (!ranges.empty() && ranges.back().first + ranges.back().second == section_start) {
+            ranges.back().second += section_size;
+        } else {
+            ranges.emplace_back(section_start, section_size);
+        }
+    }
+
+    return found;
+}
+
+}  // namespace unrealsdk::memory::impl
@@ -0,0 +1,37 @@
+#ifndef UNREALSDK_PE_SECTIONS_H
+#define UNREALSDK_PE_SECTIONS_H
+
+// Like the pattern search, this deliberately doesn't rely on the pch, so it can be tested natively.
+// This means we can't use the Windows PE header structs, and parse the raw bytes instead.
+#include "unrealsdk/pattern_search.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace unrealsdk::memory::impl {
+
+struct SectionRanges {
+    /// Pairs of the start address and length of each range.
+    std::vector<std::pair<uintptr_t, size_t>> ranges;
+    /// True if the headers couldn't be parsed, so this covers the entire image instead.
+    bool fell_back;
+};
+
+/**
+ * @brief Parses the section table of a PE image, to find the address ranges covered by a section.
+ * @note Adjacent sections are merged into a single range.
+ * @note Every header is bounds checked against the image size, so this is safe to run on arbitrary
+ *       memory.
+ *
+ * @param start The start of the image, as loaded in memory.
+ * @param size The size of the image.
+ * @param section The section to find.
+ * @return The ranges covered by the section.
+ */
+SectionRanges find_section_ranges(uintptr_t start, size_t size, Section section);
+
+}  // namespace unrealsdk::memory::impl
+
+#endif /* UNREALSDK_PE_SECTIONS_H */
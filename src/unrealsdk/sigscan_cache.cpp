@@ -0,0 +1,157 @@
+// Deliberately not using the pch, see the header
+#include "unrealsdk/sigscan_cache.h"
+
+#include <charconv>
+#include <ios>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace unrealsdk::memory::impl {
+
+namespace {
+
+const constexpr std::string_view SIGSCAN_CACHE_HEADER = "unrealsdk sigscan cache v2";
+const constexpr std::string_view SIGSCAN_CACHE_LEGACY_HEADER = "unrealsdk sigscan cache v1";
+const constexpr std::string_view SIGSCAN_CACHE_NOT_FOUND = "none";
+
+}  // namespace
+
+uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t size) {
+    // NOLINTBEGIN(readability-magic-numbers)
+    for (size_t i = 0; i < size; i++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        hash ^= data[i];
+        hash *= 0x100000001B3;
+    }
+    return hash;
+    // NOLINTEND(readability-magic-numbers)
+}
+
+uint64_t hash_pattern(const PatternView& pattern) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto hash = fnv1a(FNV1A_OFFSET_BASIS, reinterpret_cast<const uint8_t*>(&pattern.size),
+                      sizeof(pattern.size));
+    hash = fnv1a(hash, reinterpret_cast<const uint8_t*>(&pattern.section), sizeof(pattern.section));
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+    hash = fnv1a(hash, pattern.bytes, pattern.size);
+    return fnv1a(hash, pattern.mask, pattern.size);
+}
+
+SigscanCacheStatus read_sigscan_cache(std::istream& stream,
+                                      uint64_t exe_hash,
+                                      SigscanCache& cache) {
+    std::string line{};
+    if (!std::getline(stream, line)
+        || (line != SIGSCAN_CACHE_HEADER && line != SIGSCAN_CACHE_LEGACY_HEADER)) {
+        return SigscanCacheStatus::UNKNOWN_FORMAT;
+    }
+    const bool legacy = line == SIGSCAN_CACHE_LEGACY_HEADER;
+
+    std::string key{};
+    uint64_t file_exe_hash{};
+    if (!(stream >> key >> std::hex >> file_exe_hash) || key != "exe") {
+        return SigscanCacheStatus::INVALID;
+    }
+    if (file_exe_hash != exe_hash) {
+        return SigscanCacheStatus::EXE_CHANGED;
+    }
+
+    SigscanCache loaded{};
+    uint64_t pattern_hash{};
+    std::string offset_str{};
+    while (stream >> std::hex >> pattern_hash >> offset_str) {
+        if (offset_str == SIGSCAN_CACHE_NOT_FOUND) {
+            // Legacy caches may have recorded misses before the exe was unpacked, can't trust them
+            if (!legacy) {
+                loaded[pattern_hash] = NOT_FOUND;
+            }
+            continue;
+        }
+
+        size_t offset{};
+        auto end = offset_str.data() + offset_str.size();
+        auto [ptr, ec] = std::from_chars(offset_str.data(), end, offset, 16);
+        if (ec != std::errc{} || ptr != end) {
+            return SigscanCacheStatus::INVALID;
+        }
+        loaded[pattern_hash] = offset;
+    }
+
+    // If we stopped before the end of the file, something didn't parse
+    if (!stream.eof()) {
+        return SigscanCacheStatus::INVALID;
+    }
+
+    cache = std::move(loaded);
+    return SigscanCacheStatus::LOADED;
+}
+
+void write_sigscan_cache(std::ostream& stream, uint64_t exe_hash, const SigscanCache& cache) {
+    stream << SIGSCAN_CACHE_HEADER << '\n';
+    stream << "exe " << std::hex << exe_hash << '\n';
+    for (const auto& [pattern_hash, offset] : cache) {
+        stream << pattern_hash << ' ';
+        if (offset == NOT_FOUND) {
+            stream << SIGSCAN_CACHE_NOT_FOUND;
+        } else {
+            stream << offset;
+        }
+        stream << '\n';
+    }
+    stream << std::dec;
+}
+
+std::vector<size_t> resolve_from_sigscan_cache(std::span<const PatternView> patterns,
+                                               std::span<const uint64_t> hashes,
+                                               const SigscanCache& cache,
+                                               uintptr_t start,
+                                               size_t size,
+                                               std::span<uintptr_t> found) {
+    std::vector<size_t> to_scan{};
+    for (size_t i = 0; i < patterns.size(); i++) {
+        const auto& pattern = patterns[i];
+
+        auto cached = cache.find(hashes[i]);
+        if (cached != cache.end()) {
+            if (cached->second == NOT_FOUND) {
+                continue;
+            }
+
+            // Double check the cached address still matches, in case the cache's stale
+            auto offset = cached->second;
+            const PreparedPattern prepared{pattern.bytes, pattern.mask, pattern.size};
+            if (offset <= size && pattern.size <= size - offset
+                // NOLINTNEXTLINE(performance-no-int-to-ptr)
+                && prepared.matches_at(reinterpret_cast<const uint8_t*>(start + offset))) {
+                found[i] = start + offset;
+                continue;
+            }
+        }
+
+        to_scan.push_back(i);
+    }
+    return to_scan;
+}
+
+SigscanCache build_sigscan_cache(std::span<const uint64_t> hashes,
+                                 std::span<const uintptr_t> found,
+                                 const SigscanCache& old_cache,
+                                 uintptr_t start,
+                                 bool cache_misses) {
+    SigscanCache cache{};
+    for (size_t i = 0; i < hashes.size(); i++) {
+        if (found[i] != 0) {
+            cache[hashes[i]] = found[i] - start;
+            continue;
+        }
+
+        auto old = old_cache.find(hashes[i]);
+        if (cache_misses || (old != old_cache.end() && old->second == NOT_FOUND)) {
+            cache[hashes[i]] = NOT_FOUND;
+        }
+    }
+    return cache;
+}
+
+}  // namespace unrealsdk::memory::impl
@@ -0,0 +1,137 @@
+#ifndef UNREALSDK_SIGSCAN_CACHE_H
+#define UNREALSDK_SIGSCAN_CACHE_H
+
+// Like the pattern search, this deliberately doesn't rely on the pch, so it can be tested natively
+#include "unrealsdk/pattern_search.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace unrealsdk::memory::impl {
+
+/*
+Since the exe rarely changes between launches, we cache prescan results on disk, so that warm starts
+don't need to scan at all.
+
+The cache is keyed on a hash of the exe's PE headers - which include the section table, and thus
+all the section sizes - so an update to the exe invalidates it. Each found pattern is stored as an
+offset from the start of the exe, and is validated against its pattern on load, which only costs a
+single compare per pattern. If validation fails, the pattern just gets scanned for again.
+
+Patterns which weren't found are cached too, since on Willow we register patterns for multiple
+games at once, and would otherwise rescan for the other games' patterns every launch. Since trusting
+a miss means we never look for that pattern again (until the exe changes), misses are only recorded
+once we know the exe's in its final state - e.g. Steam DRM has finished unpacking it. Otherwise, a
+pattern which got missed once would never get found.
+
+The file is a simple text format:
+```
+unrealsdk sigscan cache v2
+exe <exe hash>
+<pattern hash> <offset, or "none" if not found>
+...
+```
+
+Version 1 files are still read, but may have written `none` lines before the exe was unpacked, so
+they're ignored.
+*/
+
+/// Maps pattern hashes to the offset they were found at, relative to the start of the exe, or to
+/// NOT_FOUND if they're known to be missing.
+using SigscanCache = std::unordered_map<uint64_t, size_t>;
+
+enum class SigscanCacheStatus : uint8_t {
+    /// The cache was loaded successfully.
+    LOADED,
+    /// The cache has an unknown header, so was probably written by a different version.
+    UNKNOWN_FORMAT,
+    /// The cache was corrupt.
+    INVALID,
+    /// The cache was written for a different exe.
+    EXE_CHANGED,
+};
+
+/**
+ * @brief Hashes a range of bytes, using 64-bit FNV-1a.
+ *
+ * @param hash The hash value to continue from.
+ * @param data The bytes to hash.
+ * @param size The amount of bytes to hash.
+ * @return The new hash value.
+ */
+uint64_t fnv1a(uint64_t hash, const uint8_t* data, size_t size);
+const constexpr uint64_t FNV1A_OFFSET_BASIS = 0xCBF29CE484222325;
+
+/**
+ * @brief Hashes a pattern, to identify it.
+ *
+ * @param pattern The pattern to hash.
+ * @return The hash.
+ */
+uint64_t hash_pattern(const PatternView& pattern);
+
+/**
+ * @brief Reads a sigscan cache.
+ *
+ * @param stream The stream to read from.
+ * @param exe_hash The hash of the current exe.
+ * @param cache Output map of pattern hashes to their cached offsets. Only filled if loaded.
+ * @return The status of the load.
+ */
+SigscanCacheStatus read_sigscan_cache(std::istream& stream, uint64_t exe_hash, SigscanCache& cache);
+
+/**
+ * @brief Writes a sigscan cache.
+ *
+ * @param stream The stream to write to.
+ * @param exe_hash The hash of the current exe.
+ * @param cache A map of pattern hashes to their offsets.
+ */
+void write_sigscan_cache(std::ostream& stream, uint64_t exe_hash, const SigscanCache& cache);
+
+/**
+ * @brief Resolves as many patterns as possible using a sigscan cache.
+ * @note Each cached offset is checked against its pattern before being used. Cached misses are
+ *       trusted as is.
+ *
+ * @param patterns The patterns to resolve.
+ * @param hashes The hash of each pattern.
+ * @param cache The loaded cache.
+ * @param start The start of the exe.
+ * @param size The size of the exe.
+ * @param found Output list of the found address of each pattern. Patterns which couldn't be
+ *              resolved are left untouched.
+ * @return The indexes of all patterns which still need to be scanned for.
+ */
+std::vector<size_t> resolve_from_sigscan_cache(std::span<const PatternView> patterns,
+                                               std::span<const uint64_t> hashes,
+                                               const SigscanCache& cache,
+                                               uintptr_t start,
+                                               size_t size,
+                                               std::span<uintptr_t> found);
+
+/**
+ * @brief Builds the sigscan cache to save after a prescan.
+ *
+ * @param hashes The hash of each pattern.
+ * @param found The found address of each pattern, or 0 if it wasn't found.
+ * @param old_cache The cache which was loaded before the prescan.
+ * @param start The start of the exe.
+ * @param cache_misses True if the exe is known to be in its final state, so that patterns which
+ *                     weren't found can be cached as misses. If false, only misses which were
+ *                     already cached are kept.
+ * @return The new cache.
+ */
+SigscanCache build_sigscan_cache(std::span<const uint64_t> hashes,
+                                 std::span<const uintptr_t> found,
+                                 const SigscanCache& old_cache,
+                                 uintptr_t start,
+                                 bool cache_misses);
+
+}  // namespace unrealsdk::memory::impl
+
+#endif /* UNREALSDK_SIGSCAN_CACHE_H */
@@ -42,20 +42,288 @@ static void iter_path_name(const UObject* obj, std::wstringstream& stream) {
     stream << obj->Name;
 }
 
-std::wstring UObject::get_path_name(void) const {
+/**
+ * @brief Generates an object's full path name.
+ *
+ * @param obj The object to get the path name of.
+ * @return The full path name.
+ */
+static std::wstring generate_path_name(const UObject* obj) {
     std::wstringstream stream;
-    iter_path_name(this, stream);
+    iter_path_name(obj, stream);
     return stream.str();
 }
 
 #else
 
-std::wstring UObject::get_path_name(void) const {
-    return unrealsdk::internal::uobject_path_name(this);
+/**
+ * @brief Generates an object's full path name.
+ *
+ * @param obj The object to get the path name of.
+ * @return The full path name.
+ */
+static std::wstring generate_path_name(const UObject* obj) {
+    return unrealsdk::internal::uobject_path_name(obj);
 }
 
 #endif
 
+#pragma region Path Name Cache
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Path names are requested constantly (by hooks, logging, error messages, object lookups), and getting
+one requires either a call into the engine or walking the outer chain, plus several allocations.
+
+A path name is purely determined by the name, class, and outer of the object and each of it's
+outers, so we cache them per object, alongside that chain. Re-walking the chain to check it's still
+valid is just a few reads per level, and catches both freed objects getting their address reused,
+and objects being renamed or moved.
+
+Since lookups come from every thread, the cache is split into shards, each with it's own lock, and
+each thread keeps a small front cache of it's most recent lookups. A front cache hit takes no locks,
+and doesn't touch any shared reference counts. Once a shard fills up, we evict entries one at a time
+using the clock algorithm, rather than throwing away everything.
+*/
+
+struct PathNameEntry {
+    struct ChainLink {
+        FName name;
+        UClass* cls;
+        UObject* outer;
+    };
+
+    int32_t internal_index;
+    std::vector<ChainLink> chain;
+    std::wstring path_name;
+
+    PathNameEntry(const UObject* obj, std::wstring&& path_name)
+        : internal_index(obj->InternalIndex()), path_name(std::move(path_name)) {
+        for (auto link = obj; link != nullptr; link = link->Outer()) {
+            this->chain.push_back(
+                {.name = link->Name(), .cls = link->Class(), .outer = link->Outer()});
+        }
+    }
+
+    [[nodiscard]] bool matches(const UObject* obj) const {
+        if (obj->InternalIndex() != this->internal_index) {
+            return false;
+        }
+
+        // Since we compare the outer pointer at each level, once we run out of links this will
+        // also be null, we don't need to check the length separately
+        auto link = obj;
+        for (const auto& entry : this->chain) {
+            if (link->Name() != entry.name || link->Class() != entry.cls
+                || link->Outer() != entry.outer) {
+                return false;
+            }
+            link = link->Outer();
+        }
+        return true;
+    }
+};
+
+// Entries are immutable once created, replacing one just swaps the pointer, so anyone still holding
+// the old one can keep using it
+using PathNameEntryPtr = std::shared_ptr<const PathNameEntry>;
+
+/**
+ * @brief Hashes an object pointer, dropping the low bits which are always zero due to alignment.
+ *
+ * @param obj The object.
+ * @return The hash.
+ */
+size_t hash_object(const UObject* obj) {
+    auto ptr = reinterpret_cast<uintptr_t>(obj);
+    // NOLINTNEXTLINE(readability-magic-numbers)
+    return (ptr >> 4) ^ (ptr >> 16);
+}
+
+class PathNameCacheShard {
+   public:
+    // Start evicting entries once a shard gets this big, so that freed objects don't build up
+    static const constexpr size_t MAX_ENTRIES = 0x1000;
+
+   private:
+    struct Slot {
+        const UObject* obj = nullptr;
+        PathNameEntryPtr entry;
+        // Set on every hit, cleared as the clock hand passes over it
+        std::atomic<bool> referenced{false};
+    };
+
+    std::shared_mutex mutex;
+    std::unordered_map<const UObject*, size_t> index;
+    std::unique_ptr<Slot[]> slots;  // NOLINT(modernize-avoid-c-arrays)
+    size_t used_slots = 0;
+    size_t clock_hand = 0;
+
+    /**
+     * @brief Picks the slot to store a new object in, evicting an existing entry if needed.
+     * @note Must be called with the unique lock held.
+     *
+     * @return The index of the slot.
+     */
+    size_t claim_slot(void) {
+        if (this->slots == nullptr) {
+            // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+            this->slots = std::make_unique<Slot[]>(MAX_ENTRIES);
+        }
+        if (this->used_slots < MAX_ENTRIES) {
+            return this->used_slots++;
+        }
+
+        // Give every recently used entry a second chance, evict the first one which isn't
+        while (true) {
+            auto idx = this->clock_hand;
+            this->clock_hand = (this->clock_hand + 1) % MAX_ENTRIES;
+
+            auto& slot = this->slots[idx];
+            if (!slot.referenced.exchange(false, std::memory_order_relaxed)) {
+                this->index.erase(slot.obj);
+                return idx;
+            }
+        }
+    }
+
+   public:
+    /**
+     * @brief Looks up a cached entry.
+     *
+     * @param obj The object to look up.
+     * @return The entry, or nullptr if it's not cached or is out of date.
+     */
+    PathNameEntryPtr find(const UObject* obj) {
+        const std::shared_lock lock(this->mutex);
+        auto iter = this->index.find(obj);
+        if (iter == this->index.end()) {
+            return nullptr;
+        }
+
+        auto& slot = this->slots[iter->second];
+        if (!slot.entry->matches(obj)) {
+            return nullptr;
+        }
+        // Avoid writing to the cache line if we don't need to
+        if (!slot.referenced.load(std::memory_order_relaxed)) {
+            slot.referenced.store(true, std::memory_order_relaxed);
+        }
+        return slot.entry;
+    }
+
+    /**
+     * @brief Adds an entry, replacing any existing one for the same object.
+     *
+     * @param obj The object the entry is for.
+     * @param entry The entry.
+     */
+    void insert(const UObject* obj, PathNameEntryPtr entry) {
+        const std::unique_lock lock(this->mutex);
+
+        auto iter = this->index.find(obj);
+        if (iter != this->index.end()) {
+            auto& slot = this->slots[iter->second];
+            slot.entry = std::move(entry);
+            slot.referenced.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        auto idx = this->claim_slot();
+        auto& slot = this->slots[idx];
+        slot.obj = obj;
+        slot.entry = std::move(entry);
+        slot.referenced.store(false, std::memory_order_relaxed);
+        this->index.emplace(obj, idx);
+    }
+};
+
+const constexpr size_t PATH_NAME_CACHE_SHARDS = 16;
+std::array<PathNameCacheShard, PATH_NAME_CACHE_SHARDS> path_name_cache{};
+
+/// A small, direct mapped, per thread cache in front of the shared one.
+struct PathNameFrontCache {
+    static const constexpr size_t SIZE = 64;
+
+    struct Slot {
+        const UObject* obj = nullptr;
+        PathNameEntryPtr entry;
+    };
+    std::array<Slot, SIZE> slots;
+
+    Slot& slot_for(const UObject* obj) { return this->slots[hash_object(obj) % SIZE]; }
+};
+
+thread_local PathNameFrontCache path_name_front_cache{};
+
+/**
+ * @brief Gets an object's path name entry, generating it if required.
+ *
+ * @param obj The object to get the path name of.
+ * @return The entry.
+ */
+PathNameEntryPtr get_path_name_entry(const UObject* obj) {
+    // Use different bits to the front cache, so each thread's cache spreads over all shards
+    auto& shard = path_name_cache[(hash_object(obj) / PathNameFrontCache::SIZE)
+                                  % PATH_NAME_CACHE_SHARDS];
+
+    auto entry = shard.find(obj);
+    if (entry == nullptr) {
+        entry = std::make_shared<const PathNameEntry>(obj, generate_path_name(obj));
+        shard.insert(obj, entry);
+    }
+    return entry;
+}
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void,
+               uobject_visit_path_name,
+               const UObject* obj,
+               void (*callback)(void* ctx, const wchar_t* str, size_t size),
+               void* ctx);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void,
+               uobject_visit_path_name,
+               const UObject* obj,
+               void (*callback)(void* ctx, const wchar_t* str, size_t size),
+               void* ctx) {
+    auto& slot = path_name_front_cache.slot_for(obj);
+    if (slot.obj != obj || slot.entry == nullptr || !slot.entry->matches(obj)) {
+        slot.entry = get_path_name_entry(obj);
+        slot.obj = obj;
+    }
+
+    // Take the entry out of the slot while we run the callback, since the callback might look up
+    // another path name which replaces it. Moving it doesn't need to touch the reference count.
+    auto entry = std::move(slot.entry);
+    callback(ctx, entry->path_name.data(), entry->path_name.size());
+
+    // If nothing else claimed the slot, put it back
+    if (slot.obj == obj && slot.entry == nullptr) {
+        slot.entry = std::move(entry);
+    }
+}
+#endif
+
+std::wstring UObject::get_path_name(void) const {
+    std::wstring path_name{};
+    this->format_path_name(std::back_inserter(path_name));
+    return path_name;
+}
+
+void UObject::visit_path_name(void (*callback)(void* ctx, const wchar_t* str, size_t size),
+                              void* ctx) const {
+    UNREALSDK_MANGLE(uobject_visit_path_name)(this, callback, ctx);
+}
+
+#pragma endregion
+
 bool UObject::is_instance(const UClass* cls) const {
     return this->Class()->inherits(cls);
 }
@@ -121,6 +121,25 @@ class UObject {
      */
     [[nodiscard]] std::wstring get_path_name(void) const;
 
+    /**
+     * @brief Writes the object's full path name to an output iterator.
+     * @note Path names are cached, so repeated calls for the same object don't allocate.
+     *
+     * @tparam OutputIt The output iterator type. May be a pointer into a caller-provided buffer.
+     * @param out The iterator to write to.
+     * @return The iterator past the last written character.
+     */
+    template <typename OutputIt>
+    OutputIt format_path_name(OutputIt out) const {
+        this->visit_path_name(
+            [](void* ctx, const wchar_t* str, size_t size) {
+                auto& iter = *static_cast<OutputIt*>(ctx);
+                iter = std::ranges::copy(std::wstring_view{str, size}, iter).out;
+            },
+            &out);
+        return out;
+    }
+
     /**
      * @brief Checks if this object is an instance of a class.
      * @note Does not check interfaces, only plain inheritance.
@@ -154,6 +173,16 @@ class UObject {
                                          const std::vector<UProperty*>& chain) const;
     void post_edit_change_chain_property(UProperty* prop,
                                          std::initializer_list<UProperty*> chain) const;
+
+   private:
+    /**
+     * @brief Gets the object's cached path name, and passes it to a callback.
+     *
+     * @param callback The callback to run on the path name.
+     * @param ctx An arbitrary context pointer, forwarded to the callback.
+     */
+    void visit_path_name(void (*callback)(void* ctx, const wchar_t* str, size_t size),
+                         void* ctx) const;
 };
 
 template <>
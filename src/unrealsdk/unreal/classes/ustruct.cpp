@@ -11,6 +11,7 @@
 #include "unrealsdk/unreal/offsets.h"
 #include "unrealsdk/unreal/wrappers/bound_function.h"
 #include "unrealsdk/unreal/wrappers/gobjects.h"
+#include "unrealsdk/unreal/wrappers/wrapped_struct.h"
 #include "unrealsdk/utils.h"
 
 namespace unrealsdk::unreal {
@@ -145,26 +146,135 @@ size_t UStruct::get_struct_size(void) const {
 #endif
 }
 
-UField* UStruct::find(const FName& name) const {
-    for (auto field : this->fields()) {
-        if (field->Name() == name) {
-            return field;
+#pragma region Field Index
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Looking up a field by name requires walking every field on the struct and all it's superfields, and
+some classes have hundreds of them. Instead, we lazily build a hash index the first time a struct is
+searched.
+*/
+
+struct FieldIndex {
+    // Used to detect if the struct was freed, or was otherwise modified
+    FName name;
+    UStruct* super_field;
+    UField* children;
+    UProperty* property_link;
+
+    std::unordered_map<FName, UField*> fields;
+    std::unordered_map<FName, UProperty*> properties;
+
+    FieldIndex(const UStruct* type)
+        : name(type->Name()),
+          super_field(type->SuperField()),
+          children(type->Children()),
+          property_link(type->PropertyLink()) {
+        // If multiple fields share a name, the linear search would return the first, so only
+        // insert if we don't already have an entry
+        for (auto field : type->fields()) {
+            this->fields.try_emplace(field->Name(), field);
+        }
+        for (auto prop : type->properties()) {
+            this->properties.try_emplace(prop->Name(), prop);
+        }
+    }
+
+    [[nodiscard]] bool matches(const UStruct* type) const {
+        return this->name == type->Name() && this->super_field == type->SuperField()
+               && this->children == type->Children() && this->property_link == type->PropertyLink();
+    }
+};
+
+std::shared_mutex field_indexes_mutex;
+std::unordered_map<const UStruct*, std::unique_ptr<FieldIndex>> field_indexes;
+
+/**
+ * @brief Looks up a name in a struct's field index, building it if required.
+ *
+ * @tparam Member The index member to look in.
+ * @param type The struct to search.
+ * @param name The name to search for.
+ * @return The found field, or nullptr if not found.
+ */
+template <auto Member>
+auto find_in_field_index(const UStruct* type, const FName& name) {
+    auto find = [&name](const FieldIndex& index) {
+        const auto& map = index.*Member;
+        auto iter = map.find(name);
+        return iter == map.end() ? nullptr : iter->second;
+    };
+
+    {
+        const std::shared_lock lock(field_indexes_mutex);
+        auto existing = field_indexes.find(type);
+        if (existing != field_indexes.end() && existing->second->matches(type)) {
+            return find(*existing->second);
         }
     }
 
-    throw std::invalid_argument("Couldn't find field " + (std::string)name);
+    auto new_index = std::make_unique<FieldIndex>(type);
+
+    const std::unique_lock lock(field_indexes_mutex);
+    auto& slot = field_indexes[type];
+    slot = std::move(new_index);
+    return find(*slot);
+}
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] UField*, ustruct_find, const UStruct* self, const FName* name);
+UNREALSDK_CAPI([[nodiscard]] UProperty*,
+               ustruct_find_prop,
+               const UStruct* self,
+               const FName* name);
+UNREALSDK_CAPI(void, ustruct_invalidate_caches);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] UField*, ustruct_find, const UStruct* self, const FName* name) {
+    return find_in_field_index<&FieldIndex::fields>(self, *name);
+}
+UNREALSDK_CAPI([[nodiscard]] UProperty*,
+               ustruct_find_prop,
+               const UStruct* self,
+               const FName* name) {
+    return find_in_field_index<&FieldIndex::properties>(self, *name);
+}
+UNREALSDK_CAPI(void, ustruct_invalidate_caches) {
+    {
+        const std::unique_lock lock(field_indexes_mutex);
+        field_indexes.clear();
+    }
+    impl::invalidate_struct_programs();
+}
+#endif
+
+UField* UStruct::find(const FName& name) const {
+    auto field = UNREALSDK_MANGLE(ustruct_find)(this, &name);
+    if (field == nullptr) {
+        throw std::invalid_argument("Couldn't find field " + (std::string)name);
+    }
+    return field;
 }
 
 UProperty* UStruct::find_prop(const FName& name) const {
-    for (auto prop : this->properties()) {
-        if (prop->Name() == name) {
-            return prop;
-        }
+    auto prop = UNREALSDK_MANGLE(ustruct_find_prop)(this, &name);
+    if (prop == nullptr) {
+        throw std::invalid_argument("Couldn't find property " + (std::string)name);
     }
+    return prop;
+}
 
-    throw std::invalid_argument("Couldn't find property " + (std::string)name);
+void UStruct::invalidate_caches(void) {
+    UNREALSDK_MANGLE(ustruct_invalidate_caches)();
 }
 
+#pragma endregion
+
 UFunction* UStruct::find_func_and_validate(const FName& name) const {
     return validate_type<UFunction>(this->find(name));
 }
@@ -153,6 +153,7 @@ class UStruct : public UField {
      * @brief Finds a child field/property by name.
      * @note Throws an exception if the child is not found.
      * @note When known to be a property, property lookup is more efficient.
+     * @note Lookups are cached, see `invalidate_caches` if modifying structs at runtime.
      *
      * @param name The name of the child.
      * @return The found child object.
@@ -172,6 +173,15 @@ class UStruct : public UField {
     [[nodiscard]] T* find_prop_and_validate(const FName& name) const;
     [[nodiscard]] UFunction* find_func_and_validate(const FName& name) const;
 
+    /**
+     * @brief Invalidates all cached data derived from struct layouts.
+     * @note Lookups and struct copies cache information about the struct layout, which is assumed
+     *       not to change. Call this after creating or modifying structs/classes at runtime.
+     * @note Since structs may inherit from or contain other structs, this invalidates the caches of
+     *       every struct, not just a single one.
+     */
+    static void invalidate_caches(void);
+
     /**
      * @brief Checks if this structs inherits from another.
      * @note Also returns true if this struct *is* the given struct.
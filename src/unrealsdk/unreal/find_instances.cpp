@@ -0,0 +1,194 @@
+#include "unrealsdk/pch.h"
+#include "unrealsdk/unreal/find_instances.h"
+#include "unrealsdk/unreal/classes/uclass.h"
+#include "unrealsdk/unreal/classes/uobject.h"
+#include "unrealsdk/unreal/wrappers/gobjects.h"
+#include "unrealsdk/unrealsdk.h"
+
+namespace unrealsdk::unreal {
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Finding all instances of a class naively means iterating through every single object, and walking
+each of their class's superfield chains. Instead, we keep an index from each class to all objects
+which are exactly that class.
+
+To keep it up to date, we keep a shadow copy of GObjects, holding the object and class we last saw
+in each slot. On every query we compare each slot against it (in parallel), and only update the
+index for slots which changed. This is a single linear pass with no superfield walks, and for the
+vast majority of slots finds nothing to do.
+
+Comparing the class as well as the object pointer means that if an object is freed and something
+else gets allocated at the same address, we'll still notice if it's of a different class - and if
+it's of the same class, it's still a valid result.
+*/
+
+class InstanceIndex {
+   private:
+    struct ShadowEntry {
+        UObject* obj;
+        UClass* cls;
+        // This object's position in it's class's list of instances
+        size_t pos;
+    };
+
+    std::mutex mutex;
+    std::vector<ShadowEntry> shadow;
+    // Maps each class to the GObjects indexes of all objects which are exactly that class
+    std::unordered_map<const UClass*, std::vector<size_t>> instances;
+
+    /**
+     * @brief Adds an object to the index.
+     *
+     * @param idx The object's GObjects index.
+     * @param obj The object.
+     */
+    void add(size_t idx, UObject* obj) {
+        auto cls = obj->Class();
+        auto& cls_instances = this->instances[cls];
+
+        this->shadow[idx] = {.obj = obj, .cls = cls, .pos = cls_instances.size()};
+        cls_instances.push_back(idx);
+    }
+
+    /**
+     * @brief Removes whatever object is in the given slot from the index.
+     *
+     * @param idx The GObjects index to remove.
+     */
+    void remove(size_t idx) {
+        auto& entry = this->shadow[idx];
+        if (entry.obj == nullptr) {
+            return;
+        }
+
+        // Swap remove, making sure to update the position of the object we moved
+        auto& cls_instances = this->instances[entry.cls];
+        auto moved_idx = cls_instances.back();
+        cls_instances[entry.pos] = moved_idx;
+        this->shadow[moved_idx].pos = entry.pos;
+        cls_instances.pop_back();
+
+        entry = {.obj = nullptr, .cls = nullptr, .pos = 0};
+    }
+
+    /**
+     * @brief Updates the index with any changes made since the last refresh.
+     */
+    void refresh(void) {
+        const auto& gobjects = unrealsdk::gobjects();
+        auto chunks = gobjects.chunks();
+        auto size = chunks.empty() ? 0 : chunks.back().start + chunks.back().count;
+
+        for (auto idx = size; idx < this->shadow.size(); idx++) {
+            this->remove(idx);
+        }
+        this->shadow.resize(size, {.obj = nullptr, .cls = nullptr, .pos = 0});
+
+        // Comparing against the shadow is read only, so we can do it in parallel, and only need to
+        // apply the (relatively few) changes serially
+        std::vector<std::vector<std::pair<size_t, UObject*>>> chunk_changes(chunks.size());
+        GObjects::scan_chunks(
+            chunks, [this, &chunk_changes](const GObjects::Chunk& chunk, size_t chunk_idx) {
+                auto& changes = chunk_changes[chunk_idx];
+                for (size_t i = 0; i < chunk.count; i++) {
+                    auto obj = chunk[i];
+                    const auto& entry = this->shadow[chunk.start + i];
+
+                    if (obj != entry.obj || (obj != nullptr && obj->Class() != entry.cls)) {
+                        changes.emplace_back(chunk.start + i, obj);
+                    }
+                }
+            });
+
+        for (const auto& changes : chunk_changes) {
+            for (const auto& [idx, obj] : changes) {
+                this->remove(idx);
+                if (obj != nullptr) {
+                    this->add(idx, obj);
+                }
+            }
+        }
+    }
+
+   public:
+    /**
+     * @brief Finds all instances of a class.
+     *
+     * @param cls The class to find instances of.
+     * @param include_subclasses If true, also finds instances of subclasses.
+     * @return A list of all matching objects.
+     */
+    std::vector<UObject*> find(const UClass* cls, bool include_subclasses) {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        this->refresh();
+
+        std::vector<UObject*> found{};
+        auto append = [this, &found](const std::vector<size_t>& cls_instances) {
+            for (auto idx : cls_instances) {
+                found.push_back(this->shadow[idx].obj);
+            }
+        };
+
+        if (!include_subclasses) {
+            auto iter = this->instances.find(cls);
+            if (iter != this->instances.end()) {
+                append(iter->second);
+            }
+            return found;
+        }
+
+        for (const auto& [instance_cls, cls_instances] : this->instances) {
+            if (!cls_instances.empty() && instance_cls->inherits(cls)) {
+                append(cls_instances);
+            }
+        }
+        return found;
+    }
+};
+
+InstanceIndex instance_index{};
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] UObject**,
+               find_all_instances,
+               const UClass* cls,
+               bool include_subclasses,
+               size_t& size);
+#endif
+#ifdef UNREALSDK_IMPORTING
+std::vector<UObject*> find_all_instances(const UClass* cls, bool include_subclasses) {
+    size_t size{};
+    auto ptr = UNREALSDK_MANGLE(find_all_instances)(cls, include_subclasses, size);
+
+    std::vector<UObject*> found{ptr, ptr + size};
+    u_free(ptr);
+    return found;
+}
+#else
+std::vector<UObject*> find_all_instances(const UClass* cls, bool include_subclasses) {
+    return instance_index.find(cls, include_subclasses);
+}
+#endif
+#ifdef UNREALSDK_EXPORTING
+UNREALSDK_CAPI([[nodiscard]] UObject**,
+               find_all_instances,
+               const UClass* cls,
+               bool include_subclasses,
+               size_t& size) {
+    auto found = find_all_instances(cls, include_subclasses);
+    size = found.size();
+
+    auto mem = u_malloc<UObject*>(std::max<size_t>(size, 1) * sizeof(UObject*));
+    std::ranges::copy(found, mem);
+
+    return mem;
+}
+#endif
+
+}  // namespace unrealsdk::unreal
@@ -0,0 +1,28 @@
+#ifndef UNREALSDK_UNREAL_FIND_INSTANCES_H
+#define UNREALSDK_UNREAL_FIND_INSTANCES_H
+
+#include "unrealsdk/pch.h"
+
+namespace unrealsdk::unreal {
+
+class UClass;
+class UObject;
+
+/**
+ * @brief Finds all objects which are an instance of a class.
+ * @note Backed by an index of all objects by class. Each call still makes one (parallel) linear pass
+ *       over GObjects to bring the index up to date, but this only compares each slot against the
+ *       last object and class seen there, so is cheaper than checking if every object inherits
+ *       from the class. Avoid calling this repeatedly in hot code.
+ * @note The returned objects are only guaranteed to be alive at the time of the call.
+ *
+ * @param cls The class to find instances of.
+ * @param include_subclasses If true, also finds instances of subclasses.
+ * @return A list of all matching objects.
+ */
+[[nodiscard]] std::vector<UObject*> find_all_instances(const UClass* cls,
+                                                       bool include_subclasses = true);
+
+}  // namespace unrealsdk::unreal
+
+#endif /* UNREALSDK_UNREAL_FIND_INSTANCES_H */
@@ -4,6 +4,7 @@
 #include "unrealsdk/pch.h"
 #include "unrealsdk/unreal/class_name.h"
 #include "unrealsdk/unreal/find_class.h"
+#include "unrealsdk/unreal/find_instances.h"
 #include "unrealsdk/unreal/structs/fname.h"
 #include "unrealsdk/unreal/wrappers/gobjects.h"
 #include "unrealsdk/unrealsdk.h"
@@ -60,11 +61,7 @@ class NamedObjectCache {
 
         this->uclass = this->find_uclass();
 
-        for (const auto& obj : unrealsdk::gobjects()) {
-            if (!obj->is_instance(this->uclass)) {
-                continue;
-            }
-
+        for (const auto& obj : find_all_instances(this->uclass)) {
             this->add_to_cache(reinterpret_cast<ObjectType*>(obj));
         }
     }
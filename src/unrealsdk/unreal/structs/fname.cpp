@@ -7,16 +7,116 @@
 
 namespace unrealsdk::unreal {
 
+#pragma region Construction Cache
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Constructing an FName from a string goes through the engine's name table, under it's lock. Since
+names are never removed from the table, the same string always results in the same FName, so we can
+cache them on our side.
+
+We only cache names with a number of 0, since that's the only case where the engine splits numeric
+suffixes off of the string - so the cached value is the full result of the init call.
+
+The cache is sharded, so that lookups from multiple threads rarely contend on the same lock.
+*/
+
+class FNameCache {
+   private:
+    static const constexpr size_t NUM_SHARDS = 16;
+
+    struct Shard {
+        std::shared_mutex mutex;
+        utils::StringViewMap<std::wstring, FName> names;
+    };
+    std::array<Shard, NUM_SHARDS> shards;
+
+   public:
+    /**
+     * @brief Gets the FName for the given string, creating it if required.
+     *
+     * @param str The string to get the name of.
+     * @return The FName.
+     */
+    FName get(std::wstring_view str) {
+        auto& shard = this->shards.at(std::hash<std::wstring_view>{}(str) % NUM_SHARDS);
+
+        {
+            const std::shared_lock lock(shard.mutex);
+            auto iter = shard.names.find(str);
+            if (iter != shard.names.end()) {
+                return iter->second;
+            }
+        }
+
+        // Copy the string first, since fname init needs it to be null terminated
+        std::wstring key{str};
+        FName name{};
+        unrealsdk::internal::fname_init(&name, key, 0);
+
+        const std::unique_lock lock(shard.mutex);
+        shard.names.emplace(std::move(key), name);
+        return name;
+    }
+};
+
+FNameCache fname_cache{};
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, fname_init_cached, FName* name, const wchar_t* str, size_t size);
+UNREALSDK_CAPI(void, fname_preload, const wchar_t* const* strs, const size_t* sizes, size_t count);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, fname_init_cached, FName* name, const wchar_t* str, size_t size) {
+    *name = fname_cache.get({str, size});
+}
+UNREALSDK_CAPI(void, fname_preload, const wchar_t* const* strs, const size_t* sizes, size_t count) {
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (size_t i = 0; i < count; i++) {
+        fname_cache.get({strs[i], sizes[i]});
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+#endif
+
 FName::FName(int32_t index, int32_t number) : index(index), number(number) {}
 
 FName::FName(const wchar_t* name, int32_t number) {
-    unrealsdk::internal::fname_init(this, name, number);
+    if (number == 0) {
+        UNREALSDK_MANGLE(fname_init_cached)(this, name, wcslen(name));
+    } else {
+        unrealsdk::internal::fname_init(this, name, number);
+    }
 }
 FName::FName(const std::string& name, int32_t number) : FName(utils::widen(name), number) {};
 FName::FName(const std::wstring& name, int32_t number) {
-    unrealsdk::internal::fname_init(this, name, number);
+    if (number == 0) {
+        UNREALSDK_MANGLE(fname_init_cached)(this, name.data(), name.size());
+    } else {
+        unrealsdk::internal::fname_init(this, name, number);
+    }
 }
 
+void FName::preload(std::span<const std::wstring_view> names) {
+    std::vector<const wchar_t*> strs{};
+    std::vector<size_t> sizes{};
+    strs.reserve(names.size());
+    sizes.reserve(names.size());
+    for (const auto& name : names) {
+        strs.push_back(name.data());
+        sizes.push_back(name.size());
+    }
+
+    UNREALSDK_MANGLE(fname_preload)(strs.data(), sizes.data(), names.size());
+}
+
+#pragma endregion
+
 bool FName::operator==(const FName& other) const {
     return this->index == other.index && this->number == other.number;
 }
@@ -25,51 +125,142 @@ bool FName::operator!=(const FName& other) const {
     return !operator==(other);
 }
 
-std::ostream& operator<<(std::ostream& stream, const FName& name) {
-    auto entry = unrealsdk::gnames().at(name.index);
+#pragma region String Conversion
 
-    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Names are stored as either ANSI or wide strings, depending on their contents. When converting to the
+other type, we cache the converted string per name entry. Since names are never freed or modified,
+this never goes stale, and views into it stay valid forever.
+*/
+
+template <typename CharT>
+class ConvertedNameCache {
+   private:
+    std::shared_mutex mutex;
+    // Store pointers, so that the strings don't move when the vector's resized
+    std::vector<std::unique_ptr<std::basic_string<CharT>>> names;
+
+   public:
+    /**
+     * @brief Gets the converted string for the given name entry, converting it if required.
+     *
+     * @param index The name index.
+     * @param entry The name entry.
+     * @return A view of the converted string.
+     */
+    std::basic_string_view<CharT> get(size_t index, const FNameEntry* entry) {
+        {
+            const std::shared_lock lock(this->mutex);
+            if (index < this->names.size() && this->names[index] != nullptr) {
+                return *this->names[index];
+            }
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        std::unique_ptr<std::basic_string<CharT>> converted;
+        if constexpr (std::is_same_v<CharT, char>) {
+            converted = std::make_unique<std::string>(utils::narrow(entry->WideName));
+        } else {
+            converted = std::make_unique<std::wstring>(utils::widen(entry->AnsiName));
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+
+        const std::unique_lock lock(this->mutex);
+        if (index >= this->names.size()) {
+            this->names.resize(index + 1);
+        }
+        auto& slot = this->names[index];
+        if (slot == nullptr) {
+            slot = std::move(converted);
+        }
+        return *slot;
+    }
+};
+
+ConvertedNameCache<char> narrowed_names{};
+ConvertedNameCache<wchar_t> widened_names{};
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] const char*, fname_base_name, int32_t index, size_t& size);
+UNREALSDK_CAPI([[nodiscard]] const wchar_t*, fname_base_wname, int32_t index, size_t& size);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] const char*, fname_base_name, int32_t index, size_t& size) {
+    auto entry = unrealsdk::gnames().at(index);
+
+    std::string_view str{};
     if (entry->is_wide()) {
-        stream << utils::narrow(entry->WideName);
+        str = narrowed_names.get(index, entry);
     } else {
-        stream << std::string_view{entry->AnsiName};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        str = entry->AnsiName;
     }
-    // NOLINTEND(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
 
-    if (name.number != 0) {
-        stream << '_' << std::to_string(name.number - 1);
-    }
-    return stream;
+    size = str.size();
+    return str.data();
 }
+UNREALSDK_CAPI([[nodiscard]] const wchar_t*, fname_base_wname, int32_t index, size_t& size) {
+    auto entry = unrealsdk::gnames().at(index);
 
-std::wostream& operator<<(std::wostream& stream, const FName& name) {
-    auto entry = unrealsdk::gnames().at(name.index);
-
-    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    std::wstring_view str{};
     if (entry->is_wide()) {
-        stream << std::wstring_view{entry->WideName};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        str = entry->WideName;
     } else {
-        stream << utils::widen(entry->AnsiName);
+        str = widened_names.get(index, entry);
+    }
+
+    size = str.size();
+    return str.data();
+}
+#endif
+
+std::string_view FName::base_name(void) const {
+    size_t size{};
+    auto str = UNREALSDK_MANGLE(fname_base_name)(this->index, size);
+    return {str, size};
+}
+std::wstring_view FName::base_wname(void) const {
+    size_t size{};
+    auto str = UNREALSDK_MANGLE(fname_base_wname)(this->index, size);
+    return {str, size};
+}
+
+std::ostream& operator<<(std::ostream& stream, const FName& name) {
+    stream << name.base_name();
+    if (name.number != 0) {
+        stream << '_' << (name.number - 1);
     }
-    // NOLINTEND(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    return stream;
+}
 
+std::wostream& operator<<(std::wostream& stream, const FName& name) {
+    stream << name.base_wname();
     if (name.number != 0) {
-        stream << '_' << std::to_wstring(name.number - 1);
+        stream << L'_' << (name.number - 1);
     }
     return stream;
 }
 
 FName::operator std::string() const {
-    std::ostringstream stream;
-    stream << *this;
-    return stream.str();
+    std::string str{};
+    this->format_to(std::back_inserter(str));
+    return str;
 }
 FName::operator std::wstring() const {
-    std::wostringstream stream;
-    stream << *this;
-    return stream.str();
+    std::wstring str{};
+    this->wformat_to(std::back_inserter(str));
+    return str;
 }
 
+#pragma endregion
+
 FName operator""_fn(const wchar_t* str, size_t /*len*/) {
     return FName{str};
 }
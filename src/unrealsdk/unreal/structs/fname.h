@@ -29,6 +29,15 @@ struct FName {
     explicit FName(const std::string& name, int32_t number = 0);
     explicit FName(const std::wstring& name, int32_t number = 0);
 
+    /**
+     * @brief Preloads the names for a list of strings into the construction cache.
+     * @note Names constructed from strings (with a number of 0) are automatically cached, this
+     *       just allows doing all the engine calls up front, rather than on first use.
+     *
+     * @param names The strings to preload the names of.
+     */
+    static void preload(std::span<const std::wstring_view> names);
+
     bool operator==(const FName& other) const;
     bool operator!=(const FName& other) const;
 
@@ -51,6 +60,42 @@ struct FName {
      */
     operator std::string() const;
     operator std::wstring() const;
+
+    /**
+     * @brief Gets a view of the string this name was created from, excluding the number suffix.
+     * @note Automatically converts utf8 to utf16 (or vice versa), as needed. Conversions are cached
+     *       per name entry, so repeated calls never allocate.
+     * @note Since names are never freed, the view remains valid for the lifetime of the game.
+     *
+     * @return A view of the name's string.
+     */
+    [[nodiscard]] std::string_view base_name(void) const;
+    [[nodiscard]] std::wstring_view base_wname(void) const;
+
+    /**
+     * @brief Writes the FName's string representation to an output iterator, without allocating.
+     * @note Automatically converts utf8 to utf16 (or vice versa), as needed.
+     *
+     * @tparam OutputIt The output iterator type. May be a pointer into a caller-provided buffer.
+     * @param out The iterator to write to.
+     * @return The iterator past the last written character.
+     */
+    template <typename OutputIt>
+    OutputIt format_to(OutputIt out) const {
+        out = std::ranges::copy(this->base_name(), out).out;
+        if (this->number != 0) {
+            out = std::format_to(out, "_{}", this->number - 1);
+        }
+        return out;
+    }
+    template <typename OutputIt>
+    OutputIt wformat_to(OutputIt out) const {
+        out = std::ranges::copy(this->base_wname(), out).out;
+        if (this->number != 0) {
+            out = std::format_to(out, L"_{}", this->number - 1);
+        }
+        return out;
+    }
 };
 
 #if defined(_MSC_VER) && UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW
@@ -67,14 +112,30 @@ FName operator""_fn(const wchar_t* str, size_t len);
 
 }  // namespace unrealsdk::unreal
 
-// Custom FName formatter, which just casts to a string first
+// Custom FName formatter, which avoids allocating where possible
 template <>
-struct std::formatter<unrealsdk::unreal::FName> : std::formatter<std::string> {
+struct std::formatter<unrealsdk::unreal::FName> : std::formatter<std::string_view> {
     auto format(unrealsdk::unreal::FName name, std::format_context& ctx) const {
-        return formatter<std::string>::format((std::string)name, ctx);
+        // Enough space for an underscore, a sign, and all the digits of the number suffix
+        static constexpr auto MAX_SUFFIX_SIZE = std::numeric_limits<int32_t>::digits10 + 3;
+        static constexpr auto BUFFER_SIZE = 256;
+
+        auto base_name = name.base_name();
+        if (base_name.size() + MAX_SUFFIX_SIZE > BUFFER_SIZE) {
+            return formatter<std::string_view>::format((std::string)name, ctx);
+        }
+
+        std::array<char, BUFFER_SIZE> buffer;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+        auto end = name.format_to(buffer.data());
+        return formatter<std::string_view>::format(
+            {buffer.data(), static_cast<size_t>(end - buffer.data())}, ctx);
     }
 };
 
+// Since names are never freed, FNames are safe to format later, on the logger thread
+template <>
+struct unrealsdk::logging::is_deferrable_log_arg<unrealsdk::unreal::FName> : std::true_type {};
+
 namespace std {
 
 // Custom FName hash function, which hashes as if it's a uint64
@@ -38,6 +38,126 @@ void validate_no_more_params(UProperty* prop) {
     }
 }
 
+#pragma region Params Pool
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+Calling a function needs a params struct, which is normally a fresh allocation, which gets destroyed
+and freed again as soon as the call completes. Functions called every frame end up constantly
+churning the allocator.
+
+Instead, each thread keeps a small pool of params structs per function. Once a call completes, we
+destroy its contents (freeing any strings, arrays, etc.), zero it, and hold onto it for the next
+call. Multiple are kept per function in case a call recurses back into the same function.
+*/
+
+// Params structs larger than this aren't pooled
+const constexpr size_t MAX_POOLED_SIZE = 0x400;
+// The most params structs to hold onto per function
+const constexpr size_t MAX_POOLED_PER_FUNCTION = 4;
+
+class ParamsPool {
+   private:
+    struct PooledParams {
+        void* params;
+        size_t size;
+    };
+
+    std::unordered_map<const UFunction*, std::vector<PooledParams>> pool;
+
+   public:
+    ParamsPool(void) = default;
+    ParamsPool(const ParamsPool&) = delete;
+    ParamsPool(ParamsPool&&) = delete;
+    ParamsPool& operator=(const ParamsPool&) = delete;
+    ParamsPool& operator=(ParamsPool&&) = delete;
+
+    // Deliberately leak the pooled params. This runs on thread exit, which for most threads which
+    // call unreal functions means during process shutdown, at which point the engine's allocator
+    // may already be gone. Since they're already destroyed, all we're leaking is a few small blocks
+    // of memory per thread, better to do that than risk crashing in u_free.
+    ~ParamsPool() = default;
+
+    /**
+     * @brief Gets a zero-initialized params struct.
+     *
+     * @param func The function to get a params struct for.
+     * @return A pointer to the params struct, or nullptr if it's too large to pool.
+     */
+    void* acquire(const UFunction* func) {
+        auto size = func->get_struct_size();
+        if (size > MAX_POOLED_SIZE) {
+            return nullptr;
+        }
+
+        auto& entries = this->pool[func];
+        while (!entries.empty()) {
+            auto entry = entries.back();
+            entries.pop_back();
+
+            // If the function was freed and something else allocated in its place, our params may
+            // no longer be large enough
+            if (entry.size >= size) {
+                return entry.params;
+            }
+            u_free(entry.params);
+        }
+
+        auto params = u_malloc(size);
+        memset(params, 0, size);
+        return params;
+    }
+
+    /**
+     * @brief Destroys a params struct, and returns it to the pool.
+     *
+     * @param func The function the params struct is for.
+     * @param params The params struct.
+     */
+    void release(const UFunction* func, void* params) {
+        auto size = func->get_struct_size();
+        destroy_struct(func, reinterpret_cast<uintptr_t>(params));
+
+        auto& entries = this->pool[func];
+        if (entries.size() >= MAX_POOLED_PER_FUNCTION) {
+            u_free(params);
+            return;
+        }
+
+        memset(params, 0, size);
+        entries.push_back({.params = params, .size = size});
+    }
+};
+
+thread_local ParamsPool params_pool{};
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] void*, bound_function_acquire_params, const UFunction* func);
+UNREALSDK_CAPI(void, bound_function_release_params, const UFunction* func, void* params);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] void*, bound_function_acquire_params, const UFunction* func) {
+    return params_pool.acquire(func);
+}
+UNREALSDK_CAPI(void, bound_function_release_params, const UFunction* func, void* params) {
+    params_pool.release(func, params);
+}
+#endif
+
+void* acquire_params(const UFunction* func) {
+    return UNREALSDK_MANGLE(bound_function_acquire_params)(func);
+}
+void release_params(const UFunction* func, void* params) {
+    UNREALSDK_MANGLE(bound_function_release_params)(func, params);
+}
+
+#pragma endregion
+
 }  // namespace func_params::impl
 
 UNREALSDK_CAPI(void, bound_function_call_with_params, const BoundFunction* self, void* params);
@@ -13,11 +13,48 @@
 
 namespace unrealsdk::unreal {
 
+class WrappedArray;
+class WrappedMulticastDelegate;
+
 // Helpers to translate a property parameter pack into function parameters/return values
 namespace func_params {
 
 namespace impl {
 
+/**
+ * @brief Gets a zero-initialized params struct for a function from this thread's pool.
+ * @note Must be given back using `release_params` on the same thread.
+ *
+ * @param func The function to get a params struct for.
+ * @return A pointer to the params struct, or nullptr if the function's params are too large to
+ *         pool.
+ */
+[[nodiscard]] void* acquire_params(const UFunction* func);
+
+/**
+ * @brief Destroys a params struct retrieved from `acquire_params`, and returns it to the pool.
+ *
+ * @param func The function the params struct is for.
+ * @param params The params struct.
+ */
+void release_params(const UFunction* func, void* params);
+
+/// RAII class which gives a pooled params struct back once the call is complete.
+struct PooledParamsGuard {
+    const UFunction* func;
+    void* params;
+
+    ~PooledParamsGuard() { release_params(this->func, this->params); }
+};
+
+/// RAII class which destroys a params struct in caller provided storage once the call is complete.
+struct StorageParamsGuard {
+    const UFunction* func;
+    void* params;
+
+    ~StorageParamsGuard() { destroy_struct(this->func, reinterpret_cast<uintptr_t>(this->params)); }
+};
+
 /**
  * @brief Get the next parameter property in the chain.
  * @note Includes optional properties.
@@ -98,6 +135,35 @@ void write_params(WrappedStruct& params, const typename PropTraits<Ts>::Value&..
 template <typename R>
 using return_type = std::conditional_t<std::is_void_v<R>, void, typename PropTraits<R>::Value>;
 
+/**
+ * @brief True if the return value is entirely copied out of the params struct, so that the params
+ *        may be reused as soon as the call completes.
+ * @note False for wrapper types which point back into the params struct.
+ *
+ * @tparam R The return property type.
+ */
+template <typename R>
+constexpr bool can_reuse_params = []() {
+    if constexpr (std::is_void_v<R>) {
+        return true;
+    } else {
+        using value = typename PropTraits<R>::Value;
+        return !std::is_same_v<value, WrappedArray> && !std::is_same_v<value, WrappedStruct>
+               && !std::is_same_v<value, WrappedMulticastDelegate>;
+    }
+}();
+
+/**
+ * @brief Caller provided storage for a function's params struct, typically placed on the stack.
+ *
+ * @tparam n The size of the storage.
+ */
+template <size_t n>
+struct ParamsStorage {
+    // Matches the largest alignment unreal uses for structs
+    alignas(16) std::array<uint8_t, n> data;
+};
+
 /**
  * @brief Gets the return value of a completed function call.
  *
@@ -137,6 +203,28 @@ class BoundFunction {
      */
     void call_with_params(void* params) const;
 
+    /**
+     * @brief Calls this function, using an existing zero-initialized params struct.
+     * @note The caller is responsible for destroying the params struct afterwards.
+     *
+     * @tparam R The return type.
+     * @tparam Ts The types of the arguments.
+     * @param buffer The params struct to use.
+     * @param args The arguments.
+     * @return The function's return value.
+     */
+    template <typename R, typename... Ts>
+    func_params::return_type<R> call_in_buffer(void* buffer,
+                                               const typename PropTraits<Ts>::Value&... args) {
+        WrappedStruct params{this->func, buffer};
+        func_params::write_params<Ts...>(params, args...);
+
+        this->call_with_params(buffer);
+        if constexpr (!std::is_void_v<R>) {
+            return func_params::get_return_value<R>(this->func, params);
+        }
+    }
+
    public:
     /**
      * @brief Calls this function.
@@ -149,6 +237,17 @@ class BoundFunction {
      */
     template <typename R, typename... Ts>
     func_params::return_type<R> call(const typename PropTraits<Ts>::Value&... args) {
+        // If we know the return value won't point back into the params, we can reuse a params
+        // struct from the pool rather than allocating a new one
+        if constexpr (func_params::can_reuse_params<R>) {
+            auto buffer = func_params::impl::acquire_params(this->func);
+            if (buffer != nullptr) {
+                const func_params::impl::PooledParamsGuard guard{.func = this->func,
+                                                                 .params = buffer};
+                return this->call_in_buffer<R, Ts...>(buffer, args...);
+            }
+        }
+
         WrappedStruct params{this->func};
         func_params::write_params<Ts...>(params, args...);
 
@@ -157,6 +256,7 @@ class BoundFunction {
             return func_params::get_return_value<R>(this->func, params);
         }
     }
+
     template <typename R>
     func_params::return_type<R> call(WrappedStruct& params) {
         if (params.type != this->func) {
@@ -170,6 +270,34 @@ class BoundFunction {
             return func_params::get_return_value<R>(this->func, params);
         }
     }
+
+    /**
+     * @brief Calls this function, placing it's params struct in caller provided storage.
+     * @note If the storage is too small for the params struct, falls back to a normal call.
+     *
+     * @tparam R The return type. If `void`, the return value is ignored (even if it exists).
+     * @tparam Ts The types of the arguments.
+     * @tparam n The size of the storage.
+     * @param storage The storage to use for the params struct.
+     * @param args The arguments.
+     * @return The function's return value.
+     */
+    template <typename R, typename... Ts, size_t n>
+    func_params::return_type<R> call(func_params::ParamsStorage<n>& storage,
+                                     const typename PropTraits<Ts>::Value&... args) {
+        static_assert(func_params::can_reuse_params<R>,
+                      "Return type points into the params struct, can't use caller storage");
+
+        auto size = this->func->get_struct_size();
+        if (size > n) {
+            return this->call<R, Ts...>(args...);
+        }
+
+        std::fill_n(storage.data.begin(), size, 0);
+        const func_params::impl::StorageParamsGuard guard{.func = this->func,
+                                                          .params = storage.data.data()};
+        return this->call_in_buffer<R, Ts...>(storage.data.data(), args...);
+    }
 };
 
 // UFunction isn't a property, so we don't define a prop traits class, we don't want the default
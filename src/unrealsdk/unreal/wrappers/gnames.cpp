@@ -2,6 +2,7 @@
 
 #include "unrealsdk/unreal/structs/gnames.h"
 #include "unrealsdk/unreal/wrappers/gnames.h"
+#include "unrealsdk/utils.h"
 
 namespace unrealsdk::unreal {
 
@@ -35,4 +36,209 @@ FNameEntry* GNames::at(size_t idx) const {
 #error Unknown SDK flavour
 #endif
 
+#pragma region Reverse Lookup
+
+#ifndef UNREALSDK_IMPORTING
+namespace {
+
+/*
+The engine only lets us look up names via FName::Init, which adds the name if it doesn't already
+exist. Instead, we build our own index mapping strings back to name indexes.
+
+Since names are never removed, we only need to index the new entries whenever GNames grows. Slots
+may however be reserved before their entry gets written, so we remember any we found null, and
+recheck them the next time we miss.
+*/
+
+/**
+ * @brief Lowercases a string in place, so that it can be compared case insensitively.
+ *
+ * @param str The string to lowercase.
+ */
+void to_lower(std::wstring& str) {
+    std::ranges::transform(str, str.begin(), &std::towlower);
+}
+
+class NameIndex {
+   private:
+    std::shared_mutex mutex;
+    size_t indexed_size = 0;
+    // Slots below indexed_size which were still null when we got to them, to recheck next update
+    std::vector<size_t> null_slots;
+    // Maps lowercased names to their index
+    utils::StringViewMap<std::wstring, int32_t> names;
+
+    /**
+     * @brief Adds a single entry to the index.
+     * @note Must be called with the unique lock held.
+     *
+     * @param idx The entry's index.
+     * @param entry The entry.
+     */
+    void add_entry(size_t idx, const FNameEntry* entry) {
+        std::wstring key{};
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        if (entry->is_wide()) {
+            key = entry->WideName;
+        } else {
+            // Ansi names are only used when every character is in ascii, so we can widen them
+            // without decoding
+            for (auto chr : std::string_view{entry->AnsiName}) {
+                key.push_back(static_cast<wchar_t>(static_cast<unsigned char>(chr)));
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        to_lower(key);
+
+        // If multiple entries match, keep the first - which might not be the one we saw first, if
+        // an earlier slot was null until now
+        auto [iter, inserted] = this->names.try_emplace(std::move(key), static_cast<int32_t>(idx));
+        if (!inserted && std::cmp_greater(iter->second, idx)) {
+            iter->second = static_cast<int32_t>(idx);
+        }
+    }
+
+    /**
+     * @brief Indexes any new entries in GNames, and any previously null entries which have since
+     *        been filled in.
+     * @note Must be called with the unique lock held.
+     *
+     * @param gnames The GNames array to index.
+     */
+    void update(const GNames& gnames) {
+        std::erase_if(this->null_slots, [this, &gnames](size_t idx) {
+            auto entry = gnames.at(idx);
+            if (entry == nullptr) {
+                return false;
+            }
+            this->add_entry(idx, entry);
+            return true;
+        });
+
+        auto size = gnames.size();
+        for (auto idx = this->indexed_size; idx < size; idx++) {
+            auto entry = gnames.at(idx);
+            if (entry == nullptr) {
+                this->null_slots.push_back(idx);
+                continue;
+            }
+            this->add_entry(idx, entry);
+        }
+        this->indexed_size = size;
+    }
+
+   public:
+    /**
+     * @brief Finds the index of a name.
+     *
+     * @param gnames The GNames array to search.
+     * @param key The lowercased name to search for.
+     * @return The name's index, or std::nullopt if not found.
+     */
+    std::optional<int32_t> find(const GNames& gnames, std::wstring_view key) {
+        auto find_in_index = [this, key]() -> std::optional<int32_t> {
+            auto iter = this->names.find(key);
+            if (iter == this->names.end()) {
+                return std::nullopt;
+            }
+            return iter->second;
+        };
+
+        {
+            const std::shared_lock lock(this->mutex);
+            if (this->indexed_size == gnames.size()) {
+                auto index = find_in_index();
+                // If we missed, the name might be in one of the null slots, which needs an update
+                if (index.has_value() || this->null_slots.empty()) {
+                    return index;
+                }
+            }
+        }
+
+        const std::unique_lock lock(this->mutex);
+        this->update(gnames);
+        return find_in_index();
+    }
+};
+
+NameIndex name_index{};
+
+/**
+ * @brief Splits a numeric suffix off of a name, in the same way FName::Init does.
+ *
+ * @param str The string to split.
+ * @return A pair of the base name, and the name number (i.e. one more than the suffix).
+ */
+std::pair<std::wstring_view, int32_t> split_name_number(std::wstring_view str) {
+    auto underscore = str.rfind(L'_');
+    if (underscore == std::wstring_view::npos || underscore == 0) {
+        return {str, 0};
+    }
+
+    auto digits = str.substr(underscore + 1);
+    // Leading zeros aren't allowed, since they wouldn't survive a round trip
+    if (digits.empty() || (digits.size() > 1 && digits.front() == L'0')) {
+        return {str, 0};
+    }
+
+    int32_t number = 0;
+    for (auto chr : digits) {
+        if (chr < L'0' || chr > L'9') {
+            return {str, 0};
+        }
+        auto digit = chr - L'0';
+
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        if (number > (std::numeric_limits<int32_t>::max() - 1 - digit) / 10) {
+            return {str, 0};
+        }
+        number = (number * 10) + digit;  // NOLINT(readability-magic-numbers)
+    }
+
+    return {str.substr(0, underscore), number + 1};
+}
+
+}  // namespace
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI([[nodiscard]] bool,
+               gnames_find,
+               const GNames* self,
+               const wchar_t* str,
+               size_t size,
+               FName* name);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI([[nodiscard]] bool,
+               gnames_find,
+               const GNames* self,
+               const wchar_t* str,
+               size_t size,
+               FName* name) {
+    auto [base_name, number] = split_name_number({str, size});
+
+    std::wstring key{base_name};
+    to_lower(key);
+
+    auto index = name_index.find(*self, key);
+    if (!index.has_value()) {
+        return false;
+    }
+
+    *name = {*index, number};
+    return true;
+}
+#endif
+
+std::optional<FName> GNames::find(std::wstring_view str) const {
+    FName name{};
+    if (!UNREALSDK_MANGLE(gnames_find)(this, str.data(), str.size(), &name)) {
+        return std::nullopt;
+    }
+    return name;
+}
+
+#pragma endregion
+
 }  // namespace unrealsdk::unreal
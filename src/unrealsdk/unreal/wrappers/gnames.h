@@ -3,6 +3,7 @@
 
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/unreal/structs/fname.h"
 #include "unrealsdk/unreal/structs/gnames.h"
 
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW
@@ -47,6 +48,18 @@ class GNames {
      * @return The item at that index.
      */
     [[nodiscard]] FNameEntry* at(size_t idx) const;
+
+    /**
+     * @brief Finds the FName matching a string, if one already exists.
+     * @note Unlike constructing an FName, this never creates a new name.
+     * @note Matches the engine's behaviour, splitting numeric suffixes, and being case insensitive.
+     * @note Backed by an index which is incrementally updated as new names are added, so is cheap
+     *       to call repeatedly.
+     *
+     * @param str The string to find the name of.
+     * @return The existing FName, or std::nullopt if no name matches.
+     */
+    [[nodiscard]] std::optional<FName> find(std::wstring_view str) const;
 };
 
 }  // namespace unrealsdk::unreal
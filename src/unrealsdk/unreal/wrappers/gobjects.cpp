@@ -72,6 +72,114 @@ GObjects::Iterator GObjects::end(void) {
 GObjects::GObjects(void) : internal(nullptr) {}
 GObjects::GObjects(internal_type internal) : internal(internal) {}
 
+#pragma region Parallel Scanning
+
+namespace {
+
+// The max amount of objects to put in a single chunk. Smaller chunks spread the work across threads
+// more evenly, at the cost of more overhead.
+const constexpr auto MAX_CHUNK_SIZE = 16 * 1024;
+
+}  // namespace
+
+void GObjects::scan_chunks(
+    const std::function<void(const Chunk& chunk, size_t chunk_idx)>& callback) const {
+    scan_chunks(this->chunks(), callback);
+}
+
+void GObjects::scan_chunks(
+    const std::vector<Chunk>& chunks,
+    const std::function<void(const Chunk& chunk, size_t chunk_idx)>& callback) {
+    if (chunks.empty()) {
+        return;
+    }
+
+    std::atomic<size_t> next_chunk = 0;
+    std::atomic<bool> failed = false;
+    std::mutex exception_mutex{};
+    std::exception_ptr exception{};
+
+    auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            auto chunk_idx = next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk_idx >= chunks.size()) {
+                return;
+            }
+
+            try {
+                callback(chunks[chunk_idx], chunk_idx);
+            } catch (...) {
+                const std::lock_guard<std::mutex> lock(exception_mutex);
+                if (exception == nullptr) {
+                    exception = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    auto num_workers =
+        std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), chunks.size());
+
+    {
+        // The calling thread counts as one of the workers
+        std::vector<std::jthread> threads{};
+        threads.reserve(num_workers - 1);
+        for (size_t i = 1; i < num_workers; i++) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+    }
+
+    if (exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void GObjects::for_each_parallel(const std::function<void(UObject* obj)>& callback) const {
+    this->scan_chunks([&callback](const Chunk& chunk, size_t /* chunk_idx */) {
+        for (size_t i = 0; i < chunk.count; i++) {
+            auto obj = chunk[i];
+            if (obj != nullptr) {
+                callback(obj);
+            }
+        }
+    });
+}
+
+std::vector<UObject*> GObjects::find_all_parallel(
+    const std::function<bool(UObject* obj)>& predicate) const {
+    // Collect results per chunk, so each thread only ever writes to it's own buffer, and so that we
+    // can easily merge them back in order
+    auto chunks = this->chunks();
+    std::vector<std::vector<UObject*>> chunk_results(chunks.size());
+
+    scan_chunks(chunks, [&predicate, &chunk_results](const Chunk& chunk, size_t chunk_idx) {
+        auto& results = chunk_results[chunk_idx];
+        for (size_t i = 0; i < chunk.count; i++) {
+            auto obj = chunk[i];
+            if (obj != nullptr && predicate(obj)) {
+                results.push_back(obj);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& results : chunk_results) {
+        total += results.size();
+    }
+
+    std::vector<UObject*> found{};
+    found.reserve(total);
+    for (const auto& results : chunk_results) {
+        found.insert(found.end(), results.begin(), results.end());
+    }
+    return found;
+}
+
+#pragma endregion
+
 #if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK
 
 size_t GObjects::size(void) const {
@@ -85,6 +193,34 @@ UObject* GObjects::obj_at(size_t idx) const {
     return this->internal->ObjObjects.at(idx)->Object;
 }
 
+std::vector<GObjects::Chunk> GObjects::chunks(void) const {
+    const auto& obj_objects = this->internal->ObjObjects;
+    auto count = (size_t)std::max(obj_objects.Count, 0);
+
+    std::vector<Chunk> chunks{};
+    chunks.reserve((count + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE);
+
+    // Split on the underlying chunks, and then again if they're larger than our max
+    size_t start = 0;
+    while (start < count) {
+        auto outer_idx = start / FChunkedFixedUObjectArray::NumElementsPerChunk;
+        auto inner_idx = start % FChunkedFixedUObjectArray::NumElementsPerChunk;
+
+        Chunk chunk{};
+        chunk.start = start;
+        chunk.count = std::min<size_t>(
+            {MAX_CHUNK_SIZE, FChunkedFixedUObjectArray::NumElementsPerChunk - inner_idx,
+             count - start});
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        chunk.items = &obj_objects.Objects[outer_idx][inner_idx];
+
+        chunks.push_back(chunk);
+        start += chunk.count;
+    }
+
+    return chunks;
+}
+
 UObject* GObjects::get_weak_object(const FWeakObjectPtr* ptr) const {
     if (ptr->object_serial_number == 0) {
         return nullptr;
@@ -137,6 +273,25 @@ UObject* GObjects::obj_at(size_t idx) const {
     return this->internal->at(idx);
 }
 
+std::vector<GObjects::Chunk> GObjects::chunks(void) const {
+    auto count = this->internal->size();
+
+    std::vector<Chunk> chunks{};
+    chunks.reserve((count + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE);
+
+    for (size_t start = 0; start < count; start += MAX_CHUNK_SIZE) {
+        Chunk chunk{};
+        chunk.start = start;
+        chunk.count = std::min<size_t>(MAX_CHUNK_SIZE, count - start);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        chunk.items = &this->internal->data[start];
+
+        chunks.push_back(chunk);
+    }
+
+    return chunks;
+}
+
 UObject* GObjects::get_weak_object(const FWeakObjectPtr* /* ptr */) const {
     (void)this;
     throw_version_error("Weak object pointers are not implemented in UE3");
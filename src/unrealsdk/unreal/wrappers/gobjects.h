@@ -54,6 +54,45 @@ class GObjects {
         bool operator!=(const Iterator& rhs) const;
     };
 
+    /// A contiguous range of GObjects, which can be accessed without any bounds checks.
+    struct Chunk {
+       public:
+        /// The GObjects index of the first object in this chunk.
+        size_t start;
+        /// The amount of objects in this chunk.
+        size_t count;
+
+       private:
+#if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK
+        FUObjectItem* items;
+#elif UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW
+        UObject** items;
+#else
+#error Unknown SDK flavour
+#endif
+
+        friend class GObjects;
+
+       public:
+        /**
+         * @brief Gets an object from the chunk, without any bounds checks.
+         *
+         * @param idx The index within this chunk to get. Must be less than count.
+         * @return The object at that index. May be null.
+         */
+        [[nodiscard]] UObject* operator[](size_t idx) const {
+#if UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_OAK
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return this->items[idx].Object;
+#elif UNREALSDK_FLAVOUR == UNREALSDK_FLAVOUR_WILLOW
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return this->items[idx];
+#else
+#error Unknown SDK flavour
+#endif
+        }
+    };
+
     /**
      * @brief Construct a new GObjects wrapper.
      *
@@ -91,6 +130,49 @@ class GObjects {
      */
     [[nodiscard]] static Iterator end(void);
 
+    /**
+     * @brief Splits GObjects into contiguous chunks.
+     * @note On UE4 these are the underlying chunks of the object array, on UE3 these are fixed size
+     *       slices of the array.
+     * @note Only valid until more objects are created.
+     *
+     * @return A list of chunks, in index order, covering every index in the array.
+     */
+    [[nodiscard]] std::vector<Chunk> chunks(void) const;
+
+    /**
+     * @brief Runs a callback on every chunk of GObjects, spread across a pool of worker threads.
+     * @note The callback runs concurrently on multiple threads, it must be thread safe. The calling
+     *       thread also processes chunks, this function blocks until all have been processed.
+     * @note If any callback throws, the remaining chunks are skipped, and the first exception is
+     *       rethrown on the calling thread.
+     *
+     * @param chunks The chunks to run on. Defaults to the current value of `chunks()`.
+     * @param callback The callback to run. Gets passed the chunk, and it's index in the list.
+     */
+    void scan_chunks(const std::function<void(const Chunk& chunk, size_t chunk_idx)>& callback) const;
+    static void scan_chunks(
+        const std::vector<Chunk>& chunks,
+        const std::function<void(const Chunk& chunk, size_t chunk_idx)>& callback);
+
+    /**
+     * @brief Runs a callback on every (non-null) object, spread across a pool of worker threads.
+     * @note The callback runs concurrently on multiple threads, it must be thread safe.
+     *
+     * @param callback The callback to run.
+     */
+    void for_each_parallel(const std::function<void(UObject* obj)>& callback) const;
+
+    /**
+     * @brief Finds all (non-null) objects matching a predicate, searching in parallel.
+     * @note The predicate runs concurrently on multiple threads, it must be thread safe.
+     *
+     * @param predicate The predicate to check objects against.
+     * @return All objects for which the predicate returned true, in index order.
+     */
+    [[nodiscard]] std::vector<UObject*> find_all_parallel(
+        const std::function<bool(UObject* obj)>& predicate) const;
+
     /**
      * @brief Get the object behind a weak object pointer (or null if it's invalid).
      *
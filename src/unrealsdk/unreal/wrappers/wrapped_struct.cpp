@@ -10,33 +10,219 @@
 
 namespace unrealsdk::unreal {
 
-void copy_struct(uintptr_t dest, const WrappedStruct& src) {
-    if (dest == reinterpret_cast<uintptr_t>(src.base.get())) {
-        LOG(DEV_WARNING, "Refusing to copy struct of type {} to itself, at address {:p}",
-            src.type->Name(), src.base.get());
-        return;
+#pragma region Struct Programs
+#ifndef UNREALSDK_IMPORTING
+
+namespace {
+
+/*
+Copying or destroying a struct generically means dispatching on the type of every single property,
+on every single call. Since a struct's layout never changes, we instead compile it once into a
+"program" - a flat list of steps which can be run without needing to look at the properties again.
+
+Runs of properties which can be copied bytewise (numbers, object pointers, etc.) are merged into
+single memcpys. Only properties which own resources (strings, arrays, ...) keep individual steps,
+which still go through the normal property setters, but with the type dispatch already resolved.
+Struct properties are inlined, so that their contents get merged with the outer struct's.
+*/
+
+using copy_property_func = void (*)(const UProperty* prop,
+                                    uintptr_t dest,
+                                    uintptr_t src,
+                                    const UnrealPointer<void>& parent);
+using destroy_property_func = void (*)(const UProperty* prop, uintptr_t addr);
+
+struct CopyStep {
+    enum class Kind : uint8_t {
+        MEMCPY,
+        BOOL,
+        PROPERTY,
+    };
+
+    Kind kind;
+    // Offset from the base of the struct being copied. For property steps, this is the base of
+    // the (possibly inlined) struct the property is on, the property's own offset gets added on top.
+    size_t offset;
+    // For memcpy steps, the amount of bytes to copy. For bool steps, the field mask.
+    size_t size;
+
+    // Only used for property steps
+    const UProperty* prop;
+    copy_property_func copy;
+};
+
+struct DestroyStep {
+    // Offset from the base of the struct being destroyed, to the base of the (possibly inlined)
+    // struct the property is on.
+    size_t offset;
+    const UProperty* prop;
+    destroy_property_func destroy;
+};
+
+template <typename T, typename... Ts>
+constexpr bool is_any_of = (std::is_same_v<T, Ts> || ...);
+
+/**
+ * @brief True if the given property type holds no resources, and can just be copied bytewise.
+ * @note This is an explicit allow list, any new property types must be considered individually.
+ */
+template <typename T>
+constexpr bool is_bytewise_copyable = is_any_of<T,
+                                                UByteAttributeProperty,
+                                                UByteProperty,
+                                                UClassProperty,
+                                                UComponentProperty,
+                                                UDelegateProperty,
+                                                UDoubleProperty,
+                                                UEnumProperty,
+                                                UFloatAttributeProperty,
+                                                UFloatProperty,
+                                                UInt16Property,
+                                                UInt64Property,
+                                                UInt8Property,
+                                                UIntAttributeProperty,
+                                                UInterfaceProperty,
+                                                UIntProperty,
+                                                UNameProperty,
+                                                UObjectProperty,
+                                                UUInt16Property,
+                                                UUInt32Property,
+                                                UUInt64Property,
+                                                UWeakObjectProperty>;
+
+template <typename T>
+void copy_property(const UProperty* prop,
+                   uintptr_t dest,
+                   uintptr_t src,
+                   const UnrealPointer<void>& parent) {
+    auto typed_prop = reinterpret_cast<const T*>(prop);
+    for (size_t i = 0; i < (size_t)typed_prop->ArrayDim(); i++) {
+        set_property<T>(typed_prop, i, dest, get_property<T>(typed_prop, i, src, parent));
+    }
+}
+
+template <typename T>
+void destroy_property_array(const UProperty* prop, uintptr_t addr) {
+    auto typed_prop = reinterpret_cast<const T*>(prop);
+    for (size_t i = 0; i < (size_t)typed_prop->ArrayDim(); i++) {
+        destroy_property<T>(typed_prop, i, addr);
     }
+}
+
+/**
+ * @brief Compiles the steps required to copy a struct.
+ *
+ * @param steps The list of steps to append to.
+ * @param type The type of the struct.
+ * @param base_offset The offset of the struct from the base of the outermost struct.
+ * @param params_only True if to only copy properties marked as params.
+ */
+void compile_copy_steps(std::vector<CopyStep>& steps,
+                        const UStruct* type,
+                        size_t base_offset,
+                        bool params_only) {
+    for (const auto& prop : type->properties()) {
+        if (params_only && (prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
+            continue;
+        }
 
-    for (const auto& prop : src.type->properties()) {
-        cast(prop, [dest, &src]<typename T>(const T* prop) {
-            for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
-                set_property<T>(prop, i, dest, src.get<T>(prop, i));
+        cast(prop, [&steps, base_offset]<typename T>(const T* prop) {
+            auto array_dim = (size_t)prop->ArrayDim();
+            auto element_size = (size_t)prop->ElementSize();
+            auto prop_offset = base_offset + prop->Offset_Internal();
+
+            if constexpr (is_bytewise_copyable<T>) {
+                steps.push_back({.kind = CopyStep::Kind::MEMCPY,
+                                 .offset = prop_offset,
+                                 .size = element_size * array_dim,
+                                 .prop = nullptr,
+                                 .copy = nullptr});
+            } else if constexpr (std::is_same_v<T, UBoolProperty>) {
+                // Bools may share their bitfield with other properties, can't copy it entirely
+                for (size_t i = 0; i < array_dim; i++) {
+                    steps.push_back({.kind = CopyStep::Kind::BOOL,
+                                     .offset = prop_offset + (i * element_size),
+                                     .size = prop->FieldMask(),
+                                     .prop = nullptr,
+                                     .copy = nullptr});
+                }
+            } else if constexpr (std::is_same_v<T, UStructProperty>) {
+                for (size_t i = 0; i < array_dim; i++) {
+                    compile_copy_steps(steps, prop->Struct(), prop_offset + (i * element_size),
+                                       false);
+                }
+            } else {
+                steps.push_back({.kind = CopyStep::Kind::PROPERTY,
+                                 .offset = base_offset,
+                                 .size = 0,
+                                 .prop = prop,
+                                 .copy = &copy_property<T>});
             }
         });
     }
 }
 
-void destroy_struct(const UStruct* type, uintptr_t addr) {
+/**
+ * @brief Merges all adjacent memcpy steps in a copy program.
+ *
+ * @param steps The steps to optimize.
+ */
+void merge_copy_steps(std::vector<CopyStep>& steps) {
+    // Order between different steps doesn't matter, they all touch different memory, so we're free
+    // to move all the memcpys to the front and sort them
+    auto memcpy_end = std::stable_partition(steps.begin(), steps.end(), [](const auto& step) {
+        return step.kind == CopyStep::Kind::MEMCPY;
+    });
+    std::sort(steps.begin(), memcpy_end,
+              [](const auto& lhs, const auto& rhs) { return lhs.offset < rhs.offset; });
+
+    // Only merge directly adjacent ranges, there may be gaps which we're not allowed to touch (e.g.
+    // non-param properties when copying a params struct).
+    std::vector<CopyStep> merged{};
+    merged.reserve(steps.size());
+    for (auto step = steps.begin(); step != memcpy_end; step++) {
+        if (!merged.empty()) {
+            auto& prev = merged.back();
+            if (step->offset <= prev.offset + prev.size) {
+                prev.size = std::max(prev.size, step->offset + step->size - prev.offset);
+                continue;
+            }
+        }
+        merged.push_back(*step);
+    }
+    merged.insert(merged.end(), memcpy_end, steps.end());
+
+    steps = std::move(merged);
+}
+
+/**
+ * @brief Compiles the steps required to destroy a struct.
+ *
+ * @param steps The list of steps to append to.
+ * @param type The type of the struct.
+ * @param base_offset The offset of the struct from the base of the outermost struct.
+ */
+void compile_destroy_steps(std::vector<DestroyStep>& steps, const UStruct* type, size_t base_offset) {
     for (const auto& prop : type->properties()) {
         try {
-            cast(prop, [addr]<typename T>(const T* prop) {
-                for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
-                    destroy_property<T>(prop, i, addr);
+            cast(prop, [&steps, base_offset]<typename T>(const T* prop) {
+                if constexpr (is_bytewise_copyable<T> || std::is_same_v<T, UBoolProperty>) {
+                    // Nothing to free
+                } else if constexpr (std::is_same_v<T, UStructProperty>) {
+                    auto prop_offset = base_offset + prop->Offset_Internal();
+                    for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
+                        compile_destroy_steps(steps, prop->Struct(),
+                                              prop_offset + (i * prop->ElementSize()));
+                    }
+                } else {
+                    steps.push_back({.offset = base_offset,
+                                     .prop = prop,
+                                     .destroy = &destroy_property_array<T>});
                 }
             });
         } catch (const std::exception& ex) {
-            // It's important not to throw, this is called during destructors, just continue, keep
-            // on trying to destroy the rest
+            // Destroying is called during destructors, so it's important not to throw. Just skip
+            // this property, and keep on trying to destroy the rest.
             // Log it to dev warning - don't want to use error to not freak out casusal users, this
             // should only really happen if a dev is messing with unsupported property types.
             LOG(DEV_WARNING, "Error while destroying '{}' struct: {}", type->Name(), ex.what());
@@ -44,6 +230,256 @@ void destroy_struct(const UStruct* type, uintptr_t addr) {
     }
 }
 
+/**
+ * @brief Compiles a program to copy an entire struct.
+ *
+ * @param steps The list of steps to fill.
+ * @param type The type of the struct.
+ */
+void compile_copy_all_program(std::vector<CopyStep>& steps, const UStruct* type) {
+    compile_copy_steps(steps, type, 0, false);
+    merge_copy_steps(steps);
+}
+
+/**
+ * @brief Compiles a program to copy only the params on a struct.
+ *
+ * @param steps The list of steps to fill.
+ * @param type The type of the struct.
+ */
+void compile_copy_params_program(std::vector<CopyStep>& steps, const UStruct* type) {
+    compile_copy_steps(steps, type, 0, true);
+    merge_copy_steps(steps);
+}
+
+/**
+ * @brief Compiles a program to destroy a struct.
+ *
+ * @param steps The list of steps to fill.
+ * @param type The type of the struct.
+ */
+void compile_destroy_program(std::vector<DestroyStep>& steps, const UStruct* type) {
+    compile_destroy_steps(steps, type, 0);
+}
+
+/**
+ * @brief A cache of compiled programs of a specific type, keyed by struct.
+ *
+ * @tparam Step The type of the steps in the program.
+ * @tparam compile The function used to compile new programs.
+ */
+template <typename Step, void (*compile)(std::vector<Step>& steps, const UStruct* type)>
+class ProgramCache {
+   private:
+    struct Program {
+        // Used to detect if the struct was freed, and something else got allocated in its place
+        FName name;
+        UStruct::property_size_type property_size;
+        UProperty* property_link;
+
+        std::vector<Step> steps;
+
+        [[nodiscard]] bool matches(const UStruct* type) const {
+            return this->name == type->Name() && this->property_size == type->PropertySize()
+                   && this->property_link == type->PropertyLink();
+        }
+    };
+
+    std::shared_mutex mutex;
+    std::unordered_map<const UStruct*, std::unique_ptr<Program>> programs;
+    // Other threads may still be running programs after we've replaced them, so we can never free
+    // them. Replacing programs should be incredibly rare, so just keep them around forever.
+    std::vector<std::unique_ptr<Program>> retired_programs;
+    // Incremented whenever the cache is cleared, to invalidate the thread local caches
+    std::atomic<uint32_t> generation;
+
+    // Put a thread local cache in front, so that the common case doesn't need to touch the mutex
+    struct ThreadCache {
+        uint32_t generation;
+        std::unordered_map<const UStruct*, const Program*> programs;
+    };
+    static thread_local ThreadCache thread_cache;
+
+   public:
+    /**
+     * @brief Gets the program for the given struct, compiling it if required.
+     *
+     * @param type The struct to get the program of.
+     * @return A reference to the program's steps.
+     */
+    const std::vector<Step>& get(const UStruct* type) {
+        auto current_generation = this->generation.load(std::memory_order_acquire);
+        if (thread_cache.generation != current_generation) {
+            thread_cache.programs.clear();
+            thread_cache.generation = current_generation;
+        }
+
+        auto cached = thread_cache.programs.find(type);
+        if (cached != thread_cache.programs.end() && cached->second->matches(type)) {
+            return cached->second->steps;
+        }
+
+        const Program* program = nullptr;
+        {
+            const std::shared_lock lock(this->mutex);
+            auto existing = this->programs.find(type);
+            if (existing != this->programs.end() && existing->second->matches(type)) {
+                program = existing->second.get();
+            }
+        }
+
+        if (program == nullptr) {
+            auto new_program = std::make_unique<Program>();
+            new_program->name = type->Name();
+            new_program->property_size = type->PropertySize();
+            new_program->property_link = type->PropertyLink();
+            compile(new_program->steps, type);
+
+            const std::unique_lock lock(this->mutex);
+            auto& slot = this->programs[type];
+            if (slot != nullptr) {
+                this->retired_programs.push_back(std::move(slot));
+            }
+            slot = std::move(new_program);
+            program = slot.get();
+        }
+
+        thread_cache.programs.insert_or_assign(type, program);
+        return program->steps;
+    }
+
+    /**
+     * @brief Clears all cached programs, forcing them to be recompiled on next use.
+     */
+    void clear(void) {
+        const std::unique_lock lock(this->mutex);
+        for (auto& [_, program] : this->programs) {
+            this->retired_programs.push_back(std::move(program));
+        }
+        this->programs.clear();
+        this->generation.fetch_add(1, std::memory_order_release);
+    }
+};
+
+template <typename Step, void (*compile)(std::vector<Step>& steps, const UStruct* type)>
+thread_local typename ProgramCache<Step, compile>::ThreadCache
+    ProgramCache<Step, compile>::thread_cache{};
+
+ProgramCache<CopyStep, &compile_copy_all_program> copy_all_programs{};
+ProgramCache<CopyStep, &compile_copy_params_program> copy_params_programs{};
+ProgramCache<DestroyStep, &compile_destroy_program> destroy_programs{};
+
+/**
+ * @brief Runs a copy program.
+ *
+ * @param steps The program's steps.
+ * @param dest The address of the struct to copy to.
+ * @param src The address of the struct to copy from.
+ * @param parent The parent allocation of the source struct.
+ */
+void run_copy_program(const std::vector<CopyStep>& steps,
+                      uintptr_t dest,
+                      uintptr_t src,
+                      const UnrealPointer<void>& parent) {
+    for (const auto& step : steps) {
+        switch (step.kind) {
+            case CopyStep::Kind::MEMCPY:
+                memcpy(reinterpret_cast<void*>(dest + step.offset),
+                       reinterpret_cast<void*>(src + step.offset), step.size);
+                break;
+
+            case CopyStep::Kind::BOOL: {
+                using mask_type = UBoolProperty::field_mask_type;
+                auto mask = static_cast<mask_type>(step.size);
+                auto* dest_bitfield = reinterpret_cast<mask_type*>(dest + step.offset);
+                auto* src_bitfield = reinterpret_cast<mask_type*>(src + step.offset);
+                *dest_bitfield = (*dest_bitfield & ~mask) | (*src_bitfield & mask);
+                break;
+            }
+
+            case CopyStep::Kind::PROPERTY:
+                step.copy(step.prop, dest + step.offset, src + step.offset, parent);
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+namespace impl {
+
+void invalidate_struct_programs(void) {
+    copy_all_programs.clear();
+    copy_params_programs.clear();
+    destroy_programs.clear();
+}
+
+}  // namespace impl
+
+#endif
+#pragma endregion
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, copy_struct, uintptr_t dest, const WrappedStruct* src);
+#endif
+#ifdef UNREALSDK_IMPORTING
+void copy_struct(uintptr_t dest, const WrappedStruct& src) {
+    UNREALSDK_MANGLE(copy_struct)(dest, &src);
+}
+#else
+void copy_struct(uintptr_t dest, const WrappedStruct& src) {
+    if (dest == reinterpret_cast<uintptr_t>(src.base.get())) {
+        LOG(DEV_WARNING, "Refusing to copy struct of type {} to itself, at address {:p}",
+            src.type->Name(), src.base.get());
+        return;
+    }
+
+    run_copy_program(copy_all_programs.get(src.type), dest,
+                     reinterpret_cast<uintptr_t>(src.base.get()), src.base);
+}
+#endif
+#ifdef UNREALSDK_EXPORTING
+UNREALSDK_CAPI(void, copy_struct, uintptr_t dest, const WrappedStruct* src) {
+    copy_struct(dest, *src);
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, destroy_struct, const UStruct* type, uintptr_t addr);
+#endif
+#ifdef UNREALSDK_IMPORTING
+void destroy_struct(const UStruct* type, uintptr_t addr) {
+    UNREALSDK_MANGLE(destroy_struct)(type, addr);
+}
+#else
+void destroy_struct(const UStruct* type, uintptr_t addr) {
+    for (const auto& step : destroy_programs.get(type)) {
+        try {
+            step.destroy(step.prop, addr + step.offset);
+        } catch (const std::exception& ex) {
+            // It's important not to throw, this is called during destructors, just continue, keep
+            // on trying to destroy the rest
+            LOG(DEV_WARNING, "Error while destroying '{}' struct: {}", type->Name(), ex.what());
+        }
+    }
+}
+#endif
+#ifdef UNREALSDK_EXPORTING
+UNREALSDK_CAPI(void, destroy_struct, const UStruct* type, uintptr_t addr) {
+    destroy_struct(type, addr);
+}
+#endif
+
+#ifdef UNREALSDK_SHARED
+UNREALSDK_CAPI(void, copy_params_only, uintptr_t dest, const WrappedStruct* src);
+#endif
+#ifndef UNREALSDK_IMPORTING
+UNREALSDK_CAPI(void, copy_params_only, uintptr_t dest, const WrappedStruct* src) {
+    run_copy_program(copy_params_programs.get(src->type), dest,
+                     reinterpret_cast<uintptr_t>(src->base.get()), src->base);
+}
+#endif
+
 WrappedStruct::WrappedStruct(const UStruct* type) : type(type), base(type) {}
 
 WrappedStruct::WrappedStruct(const UStruct* type, void* base, const UnrealPointer<void>& parent)
@@ -79,19 +515,7 @@ WrappedStruct WrappedStruct::copy_params_only(void) const {
         return new_struct;
     }
 
-    auto dest = reinterpret_cast<uintptr_t>(new_struct.base.get());
-    for (const auto& prop : this->type->properties()) {
-        if ((prop->PropertyFlags() & UProperty::PROP_FLAG_PARAM) == 0) {
-            continue;
-        }
-
-        cast(prop, [dest, this]<typename T>(const T* prop) {
-            for (size_t i = 0; i < (size_t)prop->ArrayDim(); i++) {
-                set_property<T>(prop, i, dest, this->get<T>(prop, i));
-            }
-        });
-    }
-
+    UNREALSDK_MANGLE(copy_params_only)(reinterpret_cast<uintptr_t>(new_struct.base.get()), this);
     return new_struct;
 }
 
@@ -120,6 +120,18 @@ void copy_struct(uintptr_t dest, const WrappedStruct& src);
  */
 void destroy_struct(const UStruct* type, uintptr_t addr);
 
+#ifndef UNREALSDK_IMPORTING
+namespace impl {
+
+/**
+ * @brief Invalidates all compiled struct copy/destroy programs.
+ * @note Use `UStruct::invalidate_caches` instead, this is only exposed so it can call it.
+ */
+void invalidate_struct_programs(void);
+
+}  // namespace impl
+#endif
+
 }  // namespace unrealsdk::unreal
 
 #endif /* UNREALSDK_UNREAL_WRAPPERS_WRAPPED_STRUCT_H */
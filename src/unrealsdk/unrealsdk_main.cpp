@@ -1,5 +1,7 @@
 #include "unrealsdk/pch.h"
 
+#include "unrealsdk/benchmark.h"
+#include "unrealsdk/call_profiler.h"
 #include "unrealsdk/config.h"
 #include "unrealsdk/game/abstract_hook.h"
 #include "unrealsdk/hook_manager.h"
@@ -70,6 +72,9 @@ bool init(const std::function<std::unique_ptr<game::AbstractHook>(void)>& game_g
     hook_instance = std::move(game);
 
     hook_instance->post_init();
+    hook_manager::impl::init();
+    call_profiler::impl::init();
+    benchmark::impl::init();
 
     return true;
 }
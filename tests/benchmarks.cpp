@@ -0,0 +1,483 @@
+#include "unrealsdk/call_log_format.h"
+#include "unrealsdk/pattern_search.h"
+#include "unrealsdk/sigscan_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+Native micro benchmarks over the parts of the sdk which don't depend on Windows or a running game.
+
+These run against synthetic data, sized to roughly match a real game: a 32mb code section, around a
+hundred registered patterns, and calls spread over a few thousand functions and objects. The engine
+bound hot paths (hook dispatch, `WrappedStruct`, `FName`) can only be measured in game, see
+`unrealsdk::benchmark`. Both write the same JSON fields for each result, so the same tooling can
+compare them between builds.
+
+Usage: unrealsdk_benchmarks [--quick] [output.json]
+
+Timings are meaningless with sanitizers enabled, configure with `-DUNREALSDK_TESTS_SANITIZE=OFF`
+and a release build type to get real numbers. `--quick` shrinks everything, to just check they still
+run.
+*/
+
+using namespace unrealsdk::memory;
+using namespace unrealsdk::memory::impl;
+using namespace unrealsdk::hook_manager::impl;
+
+namespace {
+
+struct Config {
+    // How many times to repeat each benchmark, after a single warmup run
+    size_t repetitions;
+    // The size of the fake code section to scan through
+    size_t code_size;
+    // How many patterns to use when benchmarking batch scans and the sigscan cache
+    size_t pattern_count;
+    // How many calls to record when benchmarking the call log
+    size_t call_count;
+    // How many unique functions/objects to spread calls over
+    size_t object_count;
+};
+
+const constexpr Config FULL_CONFIG{
+    .repetitions = 5,
+    .code_size = 32 * 1024 * 1024,
+    .pattern_count = 128,
+    .call_count = 1000000,
+    .object_count = 4096,
+};
+const constexpr Config QUICK_CONFIG{
+    .repetitions = 1,
+    .code_size = 1024 * 1024,
+    .pattern_count = 16,
+    .call_count = 10000,
+    .object_count = 256,
+};
+
+const constexpr size_t PATTERN_SIZE = 16;
+// A byte which we never put in the fake code section, so patterns containing it never match
+const constexpr uint8_t MISSING_BYTE = 0xD6;
+
+// Results are written here, so that the compiler can't optimize the benchmarks away
+volatile size_t sink = 0;
+
+struct Result {
+    std::string name;
+    size_t ops;
+    double mean_ns_per_op;
+    double best_ns_per_op;
+};
+
+/**
+ * @brief Times a benchmark.
+ *
+ * @tparam Func The type of the benchmark function.
+ * @param config The benchmark config.
+ * @param name The name of the benchmark.
+ * @param ops How many operations a single run of the function performs.
+ * @param func The benchmark function. Should return a value depending on all the work it did.
+ * @return The benchmark's results.
+ */
+template <typename Func>
+Result measure(const Config& config, std::string name, size_t ops, Func&& func) {
+    sink = sink + func();
+
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds best = std::chrono::nanoseconds::max();
+    for (size_t i = 0; i < config.repetitions; i++) {
+        auto start = std::chrono::steady_clock::now();
+        sink = sink + func();
+        auto time = std::chrono::steady_clock::now() - start;
+
+        total += time;
+        best = std::min(best, time);
+    }
+
+    auto ops_double = static_cast<double>(std::max<size_t>(ops, 1));
+    Result result{
+        .name = std::move(name),
+        .ops = ops,
+        .mean_ns_per_op = static_cast<double>(total.count())
+                          / static_cast<double>(config.repetitions) / ops_double,
+        .best_ns_per_op = static_cast<double>(best.count()) / ops_double,
+    };
+    (void)printf("%-40s %14.1fns/op (best %.1fns/op, %zu ops)\n", result.name.c_str(),
+                 result.mean_ns_per_op, result.best_ns_per_op, ops);
+    return result;
+}
+
+/**
+ * @brief Creates a fake code section.
+ * @note Real code is far from uniformly random, a few bytes (e.g. REX prefixes, common opcodes,
+ *       zeros and int3 padding) make up a large chunk of it. We try to roughly match this, since it
+ *       affects how often SIMD anchors match.
+ *
+ * @param size The size of the section.
+ * @return The fake code.
+ */
+std::vector<uint8_t> make_code(size_t size) {
+    const std::array<uint8_t, 12> common_bytes = {0x00, 0xFF, 0x48, 0x8B, 0x89, 0x4C,
+                                                  0x24, 0x0F, 0xCC, 0xE8, 0x85, 0xC0};
+
+    std::mt19937 rng{0xC0DE};
+    std::uniform_int_distribution<uint32_t> percent{0, 99};
+    std::uniform_int_distribution<size_t> common{0, common_bytes.size() - 1};
+    std::uniform_int_distribution<uint32_t> any_byte{0, 0xFF};
+
+    std::vector<uint8_t> code(size);
+    for (auto& byte : code) {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        byte = percent(rng) < 40 ? common_bytes.at(common(rng))
+                                 : static_cast<uint8_t>(any_byte(rng));
+        if (byte == MISSING_BYTE) {
+            byte = 0;
+        }
+    }
+    return code;
+}
+
+struct Patterns {
+    std::vector<std::array<uint8_t, PATTERN_SIZE>> bytes;
+    std::array<uint8_t, PATTERN_SIZE> mask;
+    std::vector<PatternView> views;
+};
+
+/**
+ * @brief Creates a set of patterns which won't be found, so scans have to cover the entire range.
+ * @note Both anchors are common bytes, so the SIMD filter lets through a realistic amount of
+ *       candidates, but the full compare always fails on the missing byte in the middle.
+ *
+ * @param count The amount of patterns to create.
+ * @return The patterns.
+ */
+Patterns make_patterns(size_t count) {
+    // Similar to a typical pattern, loading a global, with its address masked out
+    // NOLINTBEGIN(readability-magic-numbers)
+    Patterns patterns{
+        .bytes = {},
+        .mask = {0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF,
+                 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+        .views = {},
+    };
+    for (size_t i = 0; i < count; i++) {
+        patterns.bytes.push_back({0x48, 0x8B, 0x05, 0x00, 0x00, 0x00, 0x00, 0x48, 0x85, 0xC0,
+                                  MISSING_BYTE, static_cast<uint8_t>(i), 0x00, 0x00, 0x00, 0xC3});
+    }
+    // NOLINTEND(readability-magic-numbers)
+
+    for (const auto& bytes : patterns.bytes) {
+        patterns.views.push_back({.bytes = bytes.data(),
+                                  .mask = patterns.mask.data(),
+                                  .size = PATTERN_SIZE,
+                                  .section = Section::CODE});
+    }
+    return patterns;
+}
+
+/**
+ * @brief Runs the sigscan benchmarks.
+ *
+ * @param config The benchmark config.
+ * @param results The list to append results to.
+ */
+void benchmark_sigscan(const Config& config, std::vector<Result>& results) {
+    auto code = make_code(config.code_size);
+    auto patterns = make_patterns(config.pattern_count);
+    const PreparedPattern prepared{patterns.bytes.front().data(), patterns.mask.data(),
+                                   PATTERN_SIZE};
+    auto last = code.size() - PATTERN_SIZE;
+    auto size_mb = std::to_string(config.code_size / (1024 * 1024)) + "mb";
+
+    const std::array<std::pair<SimdLevel, std::string_view>, 3> levels = {{
+        {SimdLevel::SCALAR, "scalar"},
+        {SimdLevel::SSE2, "sse2"},
+        {SimdLevel::AVX2, "avx2"},
+    }};
+    const auto supported_level = detect_simd_level();
+    for (const auto& [level, level_name] : levels) {
+        if (level > supported_level) {
+            continue;
+        }
+        results.push_back(measure(
+            config, "find_pattern (" + std::string{level_name} + ", " + size_mb + ", not found)", 1,
+            [&]() { return find_pattern(code.data(), last, prepared, level); }));
+    }
+
+    /*
+    Compare the batch search against the alternative of scanning for each pattern separately, at
+    each SIMD level. Batch searches are multithreaded, but should still win with only a single core,
+    since they only pull memory through the cache once, rather than once per pattern.
+    */
+    for (auto count : {size_t{1}, config.pattern_count}) {
+        const std::span<const PatternView> views{patterns.views.data(), count};
+        std::vector<PreparedPattern> prepared_views{};
+        for (const auto& view : views) {
+            prepared_views.emplace_back(view.bytes, view.mask, view.size);
+        }
+        auto suffix = ", " + size_mb + ", " + std::to_string(count) + " not found)";
+
+        for (const auto& [level, level_name] : levels) {
+            if (level > supported_level) {
+                continue;
+            }
+            // Separate scalar scans take far too long to be worth running
+            if (level != SimdLevel::SCALAR) {
+                results.push_back(measure(
+                    config, "separate find_pattern (" + std::string{level_name} + suffix, 1,
+                    [&]() {
+                        size_t found = 0;
+                        for (const auto& pattern : prepared_views) {
+                            found += find_pattern(code.data(), last, pattern, level) == NOT_FOUND
+                                         ? 0
+                                         : 1;
+                        }
+                        return found;
+                    }));
+            }
+
+            results.push_back(measure(
+                config, "find_patterns_batch (" + std::string{level_name} + suffix, 1, [&]() {
+                    size_t found = 0;
+                    for (auto offset :
+                         find_patterns_batch(code.data(), code.size(), views, level)) {
+                        found += offset == NOT_FOUND ? 0 : 1;
+                    }
+                    return found;
+                }));
+        }
+    }
+}
+
+/**
+ * @brief Runs the sigscan cache benchmarks.
+ *
+ * @param config The benchmark config.
+ * @param results The list to append results to.
+ */
+void benchmark_sigscan_cache(const Config& config, std::vector<Result>& results) {
+    const uint64_t exe_hash = 0x0123456789ABCDEF;
+
+    // Plant each pattern in the fake code, so the cache is fully valid, as on a warm start
+    auto code = make_code(config.code_size);
+    auto patterns = make_patterns(config.pattern_count);
+    auto start = reinterpret_cast<uintptr_t>(code.data());
+
+    std::vector<uint64_t> hashes{};
+    SigscanCache cache{};
+    auto stride = code.size() / (patterns.views.size() + 1);
+    for (size_t i = 0; i < patterns.views.size(); i++) {
+        auto offset = (i + 1) * stride;
+        std::ranges::copy(patterns.bytes[i], code.begin() + static_cast<ptrdiff_t>(offset));
+
+        hashes.push_back(hash_pattern(patterns.views[i]));
+        cache[hashes.back()] = offset;
+    }
+
+    std::stringstream file{};
+    write_sigscan_cache(file, exe_hash, cache);
+    auto file_str = file.str();
+
+    auto count = std::to_string(patterns.views.size());
+    results.push_back(measure(config, "hash_pattern", patterns.views.size(), [&]() {
+        uint64_t combined = 0;
+        for (const auto& pattern : patterns.views) {
+            combined ^= hash_pattern(pattern);
+        }
+        return static_cast<size_t>(combined);
+    }));
+
+    results.push_back(measure(config, "read_sigscan_cache (" + count + " entries)", 1, [&]() {
+        std::istringstream stream{file_str};
+        SigscanCache loaded{};
+        (void)read_sigscan_cache(stream, exe_hash, loaded);
+        return loaded.size();
+    }));
+
+    results.push_back(
+        measure(config, "resolve_from_sigscan_cache (" + count + " valid)", 1, [&]() {
+            std::vector<uintptr_t> found(patterns.views.size(), 0);
+            auto to_scan = resolve_from_sigscan_cache(patterns.views, hashes, cache, start,
+                                                      code.size(), found);
+            return to_scan.size() + found.back();
+        }));
+}
+
+/**
+ * @brief Runs the binary call log benchmarks.
+ *
+ * @param config The benchmark config.
+ * @param results The list to append results to.
+ */
+void benchmark_call_log(const Config& config, std::vector<Result>& results) {
+    // Objects are allocated fairly close together, and most calls are on a small subset of them
+    std::mt19937 rng{0xCA11};
+    std::uniform_int_distribution<uintptr_t> offset{0, 0x100000};
+    std::vector<uintptr_t> funcs(config.object_count);
+    std::vector<uintptr_t> objs(config.object_count);
+    for (size_t i = 0; i < config.object_count; i++) {
+        funcs[i] = 0x7FF500000000 + (offset(rng) * 8);
+        objs[i] = 0x1A0000000 + (offset(rng) * 8);
+    }
+
+    const uintptr_t source = 0x7FF612340000;
+    std::geometric_distribution<size_t> hot{16.0 / static_cast<double>(config.object_count)};
+    std::vector<std::pair<uintptr_t, uintptr_t>> calls{};
+    calls.reserve(config.call_count);
+    for (size_t i = 0; i < config.call_count; i++) {
+        calls.emplace_back(funcs[hot(rng) % funcs.size()], objs[hot(rng) % objs.size()]);
+    }
+
+    // Matches the sdk's own flush size
+    const size_t flush_size = 0x10000;
+
+    results.push_back(measure(config, "call_log::Block::write_call", calls.size(), [&]() {
+        call_log::Block block{};
+        block.reserve(flush_size + (flush_size / 2));
+        size_t total = 0;
+        uint64_t now = 0;
+        for (const auto& [func, obj] : calls) {
+            if (block.size() == 0) {
+                block.reset(now);
+            }
+            // NOLINTNEXTLINE(readability-magic-numbers)
+            now += 150;
+            block.write_call(now, source, func, obj);
+            if (block.size() >= flush_size) {
+                total += block.size();
+                block.reset(0);
+            }
+        }
+        return total + block.size();
+    }));
+
+    const std::wstring path_name =
+        L"WillowPlayerController Loader.TheWorld:PersistentLevel.WillowPlayerController_0";
+    results.push_back(measure(config, "call_log::Block::write_name", config.object_count, [&]() {
+        call_log::Block block{};
+        block.reserve(flush_size + (flush_size / 2));
+        size_t total = 0;
+        for (auto obj : objs) {
+            block.write_name(obj, path_name);
+            if (block.size() >= flush_size) {
+                total += block.size();
+                block.reset(0);
+            }
+        }
+        return total + block.size();
+    }));
+}
+
+/**
+ * @brief Escapes a string for use in JSON.
+ *
+ * @param str The string to escape.
+ * @return The escaped string.
+ */
+std::string json_escape(std::string_view str) {
+    std::string escaped{};
+    escaped.reserve(str.size());
+    for (auto chr : str) {
+        if (chr == '"' || chr == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(chr);
+    }
+    return escaped;
+}
+
+/**
+ * @brief Writes the benchmark results to a file, as JSON.
+ *
+ * @param path The file to write to.
+ * @param quick True if this was a quick run.
+ * @param results The results.
+ * @return True if the file was written successfully.
+ */
+bool write_results(const char* path, bool quick, const std::vector<Result>& results) {
+    std::ofstream stream{path, std::ofstream::trunc};
+
+    const auto level = detect_simd_level();
+    const std::string_view simd_level = level == SimdLevel::AVX2   ? "avx2"
+                                        : level == SimdLevel::SSE2 ? "sse2"
+                                                                   : "scalar";
+
+#ifdef UNREALSDK_BENCHMARKS_SANITIZED
+    const bool sanitized = true;
+#else
+    const bool sanitized = false;
+#endif
+
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                   .count();
+
+    std::array<char, 256> line{};
+    stream << "{\n";
+    stream << "  \"flavour\": \"native\",\n";
+    stream << "  \"unix_time_ms\": " << now << ",\n";
+    stream << "  \"simd_level\": \"" << simd_level << "\",\n";
+    stream << "  \"sanitized\": " << (sanitized ? "true" : "false") << ",\n";
+    stream << "  \"quick\": " << (quick ? "true" : "false") << ",\n";
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        (void)snprintf(line.data(), line.size(),
+                       "\"ops\": %zu, \"mean_ns_per_op\": %.3f, \"best_ns_per_op\": %.3f",
+                       result.ops, result.mean_ns_per_op, result.best_ns_per_op);
+        stream << "    {\"name\": \"" << json_escape(result.name) << "\", " << line.data() << "}"
+               << (i + 1 == results.size() ? "" : ",") << "\n";
+    }
+    stream << "  ]\n";
+    stream << "}\n";
+
+    return stream.good();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    const char* output = nullptr;
+    for (int i = 1; i < argc; i++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const std::string_view arg{argv[i]};
+        if (arg == "--quick") {
+            quick = true;
+        } else if (output == nullptr && !arg.starts_with("-")) {
+            output = arg.data();
+        } else {
+            (void)fprintf(stderr, "usage: %s [--quick] [output.json]\n", argv[0]);
+            return 1;
+        }
+    }
+
+#ifdef UNREALSDK_BENCHMARKS_SANITIZED
+    (void)fprintf(stderr, "Warning: built with sanitizers, timings won't be representative\n");
+#endif
+
+    const auto& config = quick ? QUICK_CONFIG : FULL_CONFIG;
+
+    std::vector<Result> results{};
+    benchmark_sigscan(config, results);
+    benchmark_sigscan_cache(config, results);
+    benchmark_call_log(config, results);
+
+    if (output != nullptr) {
+        if (!write_results(output, quick, results)) {
+            (void)fprintf(stderr, "Failed to write results to %s\n", output);
+            return 1;
+        }
+        (void)printf("Wrote benchmark results to %s\n", output);
+    }
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+# Runs the call log decoder over a log written by `test_call_log_format`, and checks it produces the
+# expected TSV.
+#
+# Expects PYTHON, DECODER, LOG, EXPECTED, and ACTUAL to be defined.
+
+execute_process(
+    COMMAND "${PYTHON}" "${DECODER}" "${LOG}" -o "${ACTUAL}"
+    RESULT_VARIABLE decode_result
+)
+if(NOT decode_result EQUAL 0)
+    message(FATAL_ERROR "Failed to decode call log")
+endif()
+
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files "${EXPECTED}" "${ACTUAL}"
+    RESULT_VARIABLE compare_result
+)
+if(NOT compare_result EQUAL 0)
+    message(FATAL_ERROR "Decoded call log didn't match, compare ${EXPECTED} against ${ACTUAL}")
+endif()
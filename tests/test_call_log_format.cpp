@@ -0,0 +1,244 @@
+#include "unrealsdk/call_log_format.h"
+#include "test_utils.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace unrealsdk::hook_manager::impl::call_log;
+
+namespace {
+
+/**
+ * @brief Encodes a single value using the given writer.
+ *
+ * @param writer The function to write the value with.
+ * @return The encoded bytes.
+ */
+template <typename Func>
+std::vector<uint8_t> encode(Func writer) {
+    std::vector<uint8_t> data{};
+    writer(data);
+    return data;
+}
+
+void test_varints(void) {
+    auto varint = [](uint64_t value) {
+        return encode([value](auto& data) { write_varint(data, value); });
+    };
+    CHECK(varint(0) == std::vector<uint8_t>{0x00});
+    CHECK(varint(0x7F) == std::vector<uint8_t>{0x7F});
+    CHECK(varint(0x80) == (std::vector<uint8_t>{0x80, 0x01}));
+    CHECK(varint(300) == (std::vector<uint8_t>{0xAC, 0x02}));
+    CHECK(varint(std::numeric_limits<uint64_t>::max())
+          == (std::vector<uint8_t>{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01}));
+
+    auto delta = [](uintptr_t last, uintptr_t value) {
+        return encode([&last, value](auto& data) { write_pointer_delta(data, last, value); });
+    };
+    CHECK(delta(0x1000, 0x1000) == std::vector<uint8_t>{0x00});
+    CHECK(delta(0x1000, 0x0FFF) == std::vector<uint8_t>{0x01});
+    CHECK(delta(0x1000, 0x1001) == std::vector<uint8_t>{0x02});
+    CHECK(delta(0x1000, 0x0F00) == (std::vector<uint8_t>{0xFF, 0x03}));
+
+    uintptr_t last = 0x1234;
+    (void)encode([&last](auto& data) { write_pointer_delta(data, last, 0x5678); });
+    CHECK(last == 0x5678);
+}
+
+void test_headers(void) {
+    auto file_header = encode([](auto& data) { write_file_header(data); });
+    CHECK(file_header == (std::vector<uint8_t>{'U', 'S', 'D', 'K', 'C', 'A', 'L', 'L',  //
+                                               0x01, 0x00, 0x00, 0x00}));
+
+    Block block{};
+    block.reset(0x0102030405060708);
+    block.write_call(0x0102030405060708, 0, 0, 0);
+    CHECK(block.data() == (std::vector<uint8_t>{0x00, 0x00, 0x00, 0x00, 0x00}));
+    CHECK(block.header(0xAABBCCDD)
+          == (std::vector<uint8_t>{0x01, 0xDD, 0xCC, 0xBB, 0xAA, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03,
+                                   0x02, 0x01, 0x05, 0x00, 0x00, 0x00}));
+
+    block.reset(0);
+    CHECK(block.size() == 0);
+}
+
+/*
+Writes a log covering as many features of the format as possible, along with the TSV the decoder
+is expected to produce from it. The decoder test then runs `tools/decode_call_log.py` over the log,
+and compares its output.
+*/
+
+struct TestName {
+    uintptr_t ptr;
+    std::wstring wide;
+    std::string utf8;
+};
+
+class LogWriter {
+   private:
+    std::vector<uint8_t> file;
+    std::string expected;
+
+    struct Thread {
+        uint32_t id;
+        Block block;
+        std::unordered_map<uintptr_t, std::string> names;
+        // The lines we expect to decode from the current block
+        std::string expected;
+    };
+    std::vector<Thread> threads;
+
+   public:
+    LogWriter(void) { write_file_header(this->file); }
+
+    /**
+     * @brief Gets a thread's state, creating it if needed.
+     *
+     * @param id The thread id.
+     * @return The thread's state.
+     */
+    Thread& thread(uint32_t id) {
+        for (auto& thread : this->threads) {
+            if (thread.id == id) {
+                return thread;
+            }
+        }
+        return this->threads.emplace_back(
+            Thread{.id = id, .block = {}, .names = {}, .expected = {}});
+    }
+
+    /**
+     * @brief Records a call, naming any pointers the thread hasn't seen yet, like the sdk does.
+     *
+     * @param thread_id The thread the call is on.
+     * @param now The time of the call.
+     * @param source The source.
+     * @param func The function.
+     * @param obj The object.
+     */
+    void call(uint32_t thread_id,
+              uint64_t now,
+              const TestName& source,
+              const TestName& func,
+              const TestName& obj) {
+        auto& thread = this->thread(thread_id);
+        if (thread.block.size() == 0) {
+            thread.block.reset(now);
+        }
+
+        for (const auto* name : {&source, &func, &obj}) {
+            auto iter = thread.names.find(name->ptr);
+            if (iter == thread.names.end() || iter->second != name->utf8) {
+                thread.block.write_name(name->ptr, name->wide);
+                thread.names.insert_or_assign(name->ptr, name->utf8);
+            }
+        }
+        thread.block.write_call(now, source.ptr, func.ptr, obj.ptr);
+
+        thread.expected += std::to_string(thread_id) + '\t' + std::to_string(now) + '\t'
+                          + source.utf8 + '\t' + func.utf8 + '\t' + obj.utf8 + '\n';
+    }
+
+    /**
+     * @brief Writes out a thread's current block.
+     *
+     * @param thread_id The thread to flush.
+     */
+    void flush(uint32_t thread_id) {
+        auto& thread = this->thread(thread_id);
+        auto header = thread.block.header(thread_id);
+        this->file.insert(this->file.end(), header.begin(), header.end());
+        this->file.insert(this->file.end(), thread.block.data().begin(),
+                          thread.block.data().end());
+        thread.block.reset(0);
+
+        // Calls get decoded block by block, so they only appear in the output once flushed
+        this->expected += thread.expected;
+        thread.expected.clear();
+    }
+
+    /**
+     * @brief Saves the log, and the TSV expected from decoding it.
+     *
+     * @param log_path The path to write the log to.
+     * @param expected_path The path to write the expected TSV to.
+     * @return True if both files were written successfully.
+     */
+    [[nodiscard]] bool save(const char* log_path, const char* expected_path) const {
+        std::ofstream log{log_path, std::ios::binary | std::ios::trunc};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        log.write(reinterpret_cast<const char*>(this->file.data()),
+                  static_cast<std::streamsize>(this->file.size()));
+
+        std::ofstream expected_file{expected_path, std::ios::binary | std::ios::trunc};
+        expected_file << this->expected;
+
+        return log.good() && expected_file.good();
+    }
+};
+
+bool write_round_trip_log(const char* log_path, const char* expected_path) {
+    const constexpr uint32_t MAIN_THREAD = 1234;
+    const constexpr uint32_t OTHER_THREAD = 0xFFFFFFFF;
+
+    // Use high pointers, so the first delta in each block needs a full length varint
+    const TestName process_event{0x7FF612340000, L"ProcessEvent", "ProcessEvent"};
+    const TestName call_function{0x7FF612340100, L"CallFunction", "CallFunction"};
+    const TestName tick{0x7FF500001000, L"Function Engine.Actor:Tick",
+                        "Function Engine.Actor:Tick"};
+    const TestName render{0x7FF500000800, L"Function Engine.HUD:PostRender",
+                          "Function Engine.HUD:PostRender"};
+    const TestName player{0x1A0000000, L"WillowPlayerController Loader.TheWorld:PersistentLevel.Pc",
+                          "WillowPlayerController Loader.TheWorld:PersistentLevel.Pc"};
+    const TestName hud{0x1A0004000, L"WillowHUD Loader.TheWorld:PersistentLevel.Hud",
+                       "WillowHUD Loader.TheWorld:PersistentLevel.Hud"};
+    // Non-ascii names should be decoded from utf-16
+    const TestName accented{0x1A0002000, L"Object Caf\u00E9.\u00C6ther",
+                            "Object Caf\xC3\xA9.\xC3\x86ther"};
+    // Replaces the player's name, as if the object got freed and something else reused it
+    const TestName reused{0x1A0000000, L"Object Transient.Reused", "Object Transient.Reused"};
+
+    LogWriter writer{};
+
+    writer.call(MAIN_THREAD, 1000, process_event, tick, player);
+    // Pointers going backwards, so the deltas are negative
+    writer.call(MAIN_THREAD, 1500, process_event, render, hud);
+    writer.call(MAIN_THREAD, 1500, process_event, tick, player);
+
+    // A second thread, interleaved with the first, which sees the same objects but needs to
+    // name them again
+    writer.call(OTHER_THREAD, 1200, call_function, tick, accented);
+    writer.flush(OTHER_THREAD);
+
+    writer.flush(MAIN_THREAD);
+
+    // A second block, where names carry over, but deltas and the base time restart
+    writer.call(MAIN_THREAD, 0x123456789, process_event, render, hud);
+    writer.call(MAIN_THREAD, 0x123456790, process_event, tick, reused);
+    writer.flush(MAIN_THREAD);
+
+    writer.call(OTHER_THREAD, 0x200000000, call_function, tick, hud);
+    writer.flush(OTHER_THREAD);
+
+    return writer.save(log_path, expected_path);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    test_varints();
+    test_headers();
+
+    if (argc != 3) {
+        (void)fprintf(stderr, "usage: %s <log output> <expected tsv output>\n", argv[0]);
+        return 1;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    CHECK(write_round_trip_log(argv[1], argv[2]));
+
+    return unrealsdk::tests::result();
+}
@@ -0,0 +1,327 @@
+#include "unrealsdk/pattern_search.h"
+#include "test_utils.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace unrealsdk::memory;
+using namespace unrealsdk::memory::impl;
+
+namespace {
+
+// Enough to cover several full AVX2 blocks, and every possible tail length after them
+const constexpr size_t MAX_BUFFER_SIZE = 300;
+const constexpr size_t MAX_PATTERN_SIZE = 40;
+const constexpr size_t RANDOM_TRIALS = 20000;
+
+const SimdLevel supported_level = detect_simd_level();
+
+struct TestPattern {
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask;
+
+    [[nodiscard]] PreparedPattern prepare(void) const {
+        return {this->bytes.data(), this->mask.data(), this->bytes.size()};
+    }
+};
+
+/**
+ * @brief The simplest possible search, to compare everything else against.
+ *
+ * @param buffer The buffer to search.
+ * @param pattern The pattern to search for.
+ * @return The offset the pattern was found at, or NOT_FOUND.
+ */
+size_t reference_search(const std::vector<uint8_t>& buffer, const TestPattern& pattern) {
+    for (size_t i = 0; i + pattern.bytes.size() <= buffer.size(); i++) {
+        bool matches = true;
+        for (size_t j = 0; j < pattern.bytes.size(); j++) {
+            if ((buffer[i + j] & pattern.mask[j]) != pattern.bytes[j]) {
+                matches = false;
+                break;
+            }
+        }
+        if (matches) {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+
+/**
+ * @brief Checks every implementation finds the same result as the reference search.
+ *
+ * @param buffer The buffer to search. Should be exactly sized, so overreads are caught.
+ * @param pattern The pattern to search for.
+ * @return True if all implementations agreed.
+ */
+bool check_all_agree(const std::vector<uint8_t>& buffer, const TestPattern& pattern) {
+    auto expected = reference_search(buffer, pattern);
+    auto prepared = pattern.prepare();
+    auto last = buffer.size() - pattern.bytes.size();
+
+    bool passed = CHECK(find_pattern_scalar(buffer.data(), 0, last, prepared) == expected);
+    passed &= CHECK(find_pattern(buffer.data(), last, prepared, SimdLevel::SCALAR) == expected);
+
+    if (prepared.has_anchor) {
+        if (supported_level >= SimdLevel::SSE2) {
+            passed &= CHECK(find_pattern_sse2(buffer.data(), last, prepared) == expected);
+            passed &= CHECK(find_pattern(buffer.data(), last, prepared, SimdLevel::SSE2)
+                            == expected);
+        }
+        if (supported_level >= SimdLevel::AVX2) {
+            passed &= CHECK(find_pattern_avx2(buffer.data(), last, prepared) == expected);
+            passed &= CHECK(find_pattern(buffer.data(), last, prepared, SimdLevel::AVX2)
+                            == expected);
+        }
+    }
+
+    return passed;
+}
+
+/**
+ * @brief Creates a pattern matching the given region of a buffer.
+ *
+ * @param buffer The buffer to copy from.
+ * @param offset The offset to copy from.
+ * @param mask The mask to use. Also sets the size of the pattern.
+ * @return The pattern.
+ */
+TestPattern pattern_from(const std::vector<uint8_t>& buffer,
+                         size_t offset,
+                         const std::vector<uint8_t>& mask) {
+    TestPattern pattern{.bytes = {}, .mask = mask};
+    for (size_t i = 0; i < mask.size(); i++) {
+        pattern.bytes.push_back(buffer[offset + i] & mask[i]);
+    }
+    return pattern;
+}
+
+void test_edge_cases(void) {
+    std::mt19937 rng{1};
+    std::uniform_int_distribution<uint32_t> byte_dist{0, 0xFF};
+
+    // Sizes around each block boundary, so the match lands in both the SIMD loop and the tail
+    for (size_t size : {1, 2, 15, 16, 17, 31, 32, 33, 47, 48, 63, 64, 65, 95, 96, 97}) {
+        std::vector<uint8_t> buffer(size);
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(byte_dist(rng));
+        }
+
+        for (size_t pattern_size = 1; pattern_size <= std::min<size_t>(size, 5); pattern_size++) {
+            std::vector<uint8_t> mask(pattern_size, 0xFF);
+
+            // Match at offset 0
+            CHECK(check_all_agree(buffer, pattern_from(buffer, 0, mask)));
+            // Match ending on the last byte
+            CHECK(check_all_agree(buffer, pattern_from(buffer, size - pattern_size, mask)));
+
+            // Anchor somewhere other than the first byte
+            if (pattern_size > 1) {
+                mask[0] = 0;
+                CHECK(check_all_agree(buffer, pattern_from(buffer, size - pattern_size, mask)));
+            }
+        }
+
+        // A pattern the same size as the buffer, so there's only a single candidate
+        CHECK(check_all_agree(buffer, pattern_from(buffer, 0, std::vector<uint8_t>(size, 0xFF))));
+    }
+
+    // Only the last byte matches, so every earlier candidate has to be rejected
+    std::vector<uint8_t> zeros(MAX_BUFFER_SIZE, 0);
+    zeros.back() = 1;
+    const TestPattern last_byte{.bytes = {1}, .mask = {0xFF}};
+    CHECK(check_all_agree(zeros, last_byte));
+    CHECK(reference_search(zeros, last_byte) == zeros.size() - 1);
+
+    // No match at all
+    const TestPattern missing{.bytes = {2}, .mask = {0xFF}};
+    CHECK(check_all_agree(zeros, missing));
+    CHECK(reference_search(zeros, missing) == NOT_FOUND);
+
+    // Both anchors match everywhere, but the bytes between them never do
+    std::vector<uint8_t> repeating(MAX_BUFFER_SIZE, 0xAA);
+    const TestPattern between{.bytes = {0xAA, 0xBB, 0xAA}, .mask = {0xFF, 0xFF, 0xFF}};
+    CHECK(check_all_agree(repeating, between));
+
+    // A pattern without any fully unmasked bytes, which can't use SIMD
+    const TestPattern no_anchor{.bytes = {0xA0, 0x00}, .mask = {0xF0, 0x00}};
+    CHECK(!no_anchor.prepare().has_anchor);
+    CHECK(check_all_agree(repeating, no_anchor));
+    CHECK(find_pattern(repeating.data(), repeating.size() - 2, no_anchor.prepare(), supported_level)
+          == 0);
+}
+
+void test_anchor_selection(void) {
+    const TestPattern pattern{.bytes = {0x00, 0x12, 0x30, 0x45, 0x00},
+                              .mask = {0x00, 0xFF, 0xF0, 0xFF, 0x00}};
+    auto prepared = pattern.prepare();
+    CHECK(prepared.has_anchor);
+    CHECK(prepared.first_anchor == 1);
+    CHECK(prepared.second_anchor == 3);
+
+    const TestPattern single{.bytes = {0x00, 0x12}, .mask = {0x0F, 0xFF}};
+    auto single_prepared = single.prepare();
+    CHECK(single_prepared.has_anchor);
+    CHECK(single_prepared.first_anchor == 1);
+    CHECK(single_prepared.second_anchor == 1);
+}
+
+void test_random(void) {
+    std::mt19937 rng{0x5EED};
+    std::uniform_int_distribution<uint32_t> any_byte{0, 0xFF};
+
+    for (size_t trial = 0; trial < RANDOM_TRIALS; trial++) {
+        // Use a small alphabet, so that anchors match often and the full compare gets exercised
+        auto alphabet = std::uniform_int_distribution<uint32_t>{1, 4}(rng);
+        std::uniform_int_distribution<uint32_t> byte_dist{0, alphabet};
+
+        std::vector<uint8_t> buffer(std::uniform_int_distribution<size_t>{1, MAX_BUFFER_SIZE}(rng));
+        for (auto& byte : buffer) {
+            byte = static_cast<uint8_t>(byte_dist(rng));
+        }
+
+        auto pattern_size = std::uniform_int_distribution<size_t>{
+            1, std::min(buffer.size(), MAX_PATTERN_SIZE)}(rng);
+        std::vector<uint8_t> mask(pattern_size);
+        for (auto& byte : mask) {
+            switch (std::uniform_int_distribution<uint32_t>{0, 3}(rng)) {
+                case 0:
+                    byte = 0;
+                    break;
+                case 1:
+                    byte = static_cast<uint8_t>(any_byte(rng));
+                    break;
+                default:
+                    byte = 0xFF;
+                    break;
+            }
+        }
+
+        // Plant the pattern somewhere which tends to hit edge cases
+        auto last = buffer.size() - pattern_size;
+        size_t offset{};
+        switch (std::uniform_int_distribution<uint32_t>{0, 3}(rng)) {
+            case 0:
+                offset = 0;
+                break;
+            case 1:
+                offset = last;
+                break;
+            case 2:
+                // Within the last block, which gets handled by the scalar tail
+                offset = last - std::min<size_t>(last, std::uniform_int_distribution<size_t>{
+                                                           0, 31}(rng));
+                break;
+            default:
+                offset = std::uniform_int_distribution<size_t>{0, last}(rng);
+                break;
+        }
+        auto pattern = pattern_from(buffer, offset, mask);
+
+        // Sometimes change the pattern, so it usually won't be found at all
+        if (std::uniform_int_distribution<uint32_t>{0, 3}(rng) == 0) {
+            for (size_t i = 0; i < pattern_size; i++) {
+                if (mask[i] == 0xFF) {
+                    pattern.bytes[i] = static_cast<uint8_t>(alphabet + 1);
+                    break;
+                }
+            }
+        }
+
+        if (!check_all_agree(buffer, pattern)) {
+            (void)fprintf(stderr, "  in random trial %zu\n", trial);
+        }
+    }
+}
+
+void test_batch(void) {
+    std::mt19937 rng{0xBA7C4};
+    std::uniform_int_distribution<uint32_t> byte_dist{0, 3};
+
+    // Big enough to be split between multiple threads, assuming a multicore machine
+    const size_t size = (3 * 1024 * 1024) + 123;
+    std::vector<uint8_t> buffer(size);
+    for (auto& byte : buffer) {
+        byte = static_cast<uint8_t>(byte_dist(rng));
+    }
+
+    // Plant some long patterns, so they're (almost certainly) unique, including near the start,
+    // the end, around every megabyte, where the thread boundaries tend to fall, and straddling a
+    // SIMD chunk boundary
+    std::vector<TestPattern> test_patterns{};
+    std::vector<size_t> offsets = {0, 1, size - 24, size - 25, (3 * 32 * 1024) - 12};
+    for (size_t mb = 1; mb <= 3; mb++) {
+        for (size_t delta : {0, 1, 2, 23}) {
+            offsets.push_back((mb * 1024 * 1024) - delta);
+        }
+    }
+    for (auto offset : offsets) {
+        std::vector<uint8_t> mask(24, 0xFF);
+        // Leave the first byte unmasked, so the anchor isn't the first byte
+        mask[0] = 0;
+        for (size_t i = 0; i < mask.size(); i++) {
+            buffer[offset + i] = static_cast<uint8_t>(0x10 + ((offset + i) % 0xEF));
+        }
+        test_patterns.push_back(pattern_from(buffer, offset, mask));
+    }
+
+    // Patterns which are very common, which aren't anywhere, and which don't have an anchor
+    test_patterns.push_back({.bytes = {0, 1}, .mask = {0xFF, 0xFF}});
+    test_patterns.push_back({.bytes = {0xFF, 0xFE}, .mask = {0xFF, 0xFF}});
+    test_patterns.push_back({.bytes = {0x10, 0x00}, .mask = {0xF0, 0x00}});
+    // A pattern bigger than the buffer
+    const TestPattern huge{.bytes = std::vector<uint8_t>(size + 1, 0),
+                           .mask = std::vector<uint8_t>(size + 1, 0xFF)};
+    test_patterns.push_back(huge);
+
+    std::vector<PatternView> views{};
+    for (const auto& pattern : test_patterns) {
+        views.push_back({.bytes = pattern.bytes.data(),
+                         .mask = pattern.mask.data(),
+                         .size = pattern.bytes.size()});
+    }
+
+    std::vector<size_t> expected{};
+    for (const auto& pattern : test_patterns) {
+        expected.push_back(reference_search(buffer, pattern));
+    }
+
+    // The scalar and SIMD versions use completely different approaches, so test them all
+    for (auto level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (level > supported_level) {
+            continue;
+        }
+
+        auto found = find_patterns_batch(buffer.data(), buffer.size(), views, level);
+        CHECK(found.size() == test_patterns.size());
+        for (size_t i = 0; i < test_patterns.size(); i++) {
+            if (!CHECK(found[i] == expected[i])) {
+                (void)fprintf(stderr, "  for batch pattern %zu, simd level %d\n", i,
+                              static_cast<int>(level));
+            }
+        }
+
+        // Should also work on tiny buffers, and with no patterns at all
+        CHECK(find_patterns_batch(buffer.data(), 1, views, level)
+              == std::vector<size_t>(test_patterns.size(), NOT_FOUND));
+        CHECK(find_patterns_batch(buffer.data(), buffer.size(), {}, level).empty());
+    }
+}
+
+}  // namespace
+
+int main(void) {
+    const char* level_name = supported_level == SimdLevel::AVX2   ? "AVX2"
+                             : supported_level == SimdLevel::SSE2 ? "SSE2"
+                                                                  : "scalar only";
+    (void)printf("Testing with SIMD level: %s\n", level_name);
+
+    test_anchor_selection();
+    test_edge_cases();
+    test_random();
+    test_batch();
+
+    return unrealsdk::tests::result();
+}
@@ -0,0 +1,199 @@
+#include "unrealsdk/pe_sections.h"
+#include "test_utils.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+using namespace unrealsdk::memory;
+using namespace unrealsdk::memory::impl;
+
+namespace {
+
+const constexpr size_t IMAGE_SIZE = 0x5000;
+const constexpr int32_t NT_OFFSET = 0x80;
+// Matches a 64-bit optional header, but we should only ever use the size field
+const constexpr uint16_t OPTIONAL_HEADER_SIZE = 0xF0;
+
+const constexpr uint32_t SCN_CNT_CODE = 0x00000020;
+const constexpr uint32_t SCN_CNT_INITIALIZED_DATA = 0x00000040;
+const constexpr uint32_t SCN_CNT_UNINITIALIZED_DATA = 0x00000080;
+const constexpr uint32_t SCN_MEM_EXECUTE = 0x20000000;
+const constexpr uint32_t SCN_MEM_READ = 0x40000000;
+const constexpr uint32_t SCN_MEM_WRITE = 0x80000000;
+
+struct TestSection {
+    uint32_t virtual_address;
+    uint32_t virtual_size;
+    uint32_t raw_size;
+    uint32_t characteristics;
+};
+
+template <typename T>
+void write(std::vector<uint8_t>& image, size_t offset, T value) {
+    memcpy(&image[offset], &value, sizeof(T));
+}
+
+/**
+ * @brief Builds a PE image with the given sections.
+ *
+ * @param sections The sections to add.
+ * @param size The size of the image.
+ * @return The image.
+ */
+std::vector<uint8_t> build_image(const std::vector<TestSection>& sections,
+                                 size_t size = IMAGE_SIZE) {
+    std::vector<uint8_t> image(size, 0);
+
+    write<uint16_t>(image, 0x00, 0x5A4D);
+    write<int32_t>(image, 0x3C, NT_OFFSET);
+
+    write<uint32_t>(image, NT_OFFSET, 0x00004550);
+    write<uint16_t>(image, NT_OFFSET + 0x06, static_cast<uint16_t>(sections.size()));
+    write<uint16_t>(image, NT_OFFSET + 0x14, OPTIONAL_HEADER_SIZE);
+
+    auto header = NT_OFFSET + 0x18 + OPTIONAL_HEADER_SIZE;
+    for (const auto& section : sections) {
+        memcpy(&image[header], ".section", 8);
+        write<uint32_t>(image, header + 0x08, section.virtual_size);
+        write<uint32_t>(image, header + 0x0C, section.virtual_address);
+        write<uint32_t>(image, header + 0x10, section.raw_size);
+        write<uint32_t>(image, header + 0x24, section.characteristics);
+        header += 0x28;
+    }
+
+    return image;
+}
+
+using Ranges = std::vector<std::pair<uintptr_t, size_t>>;
+
+/**
+ * @brief Finds the ranges covered by a section, relative to the start of the image.
+ *
+ * @param image The image.
+ * @param section The section to find.
+ * @param fell_back Output for if parsing fell back to the entire image.
+ * @return The relative ranges.
+ */
+Ranges relative_ranges(const std::vector<uint8_t>& image, Section section, bool& fell_back) {
+    auto start = reinterpret_cast<uintptr_t>(image.data());
+    auto found = find_section_ranges(start, image.size(), section);
+    fell_back = found.fell_back;
+
+    Ranges relative{};
+    for (const auto& [range_start, range_size] : found.ranges) {
+        relative.emplace_back(range_start - start, range_size);
+    }
+    return relative;
+}
+
+const std::vector<TestSection> typical_sections = {
+    // .text
+    {0x1000, 0x0800, 0x0800, SCN_CNT_CODE | SCN_MEM_EXECUTE | SCN_MEM_READ},
+    // A second code section, directly after the first
+    {0x1800, 0x0700, 0x0800, SCN_CNT_CODE | SCN_MEM_EXECUTE | SCN_MEM_READ},
+    // .rdata
+    {0x2000, 0x0900, 0x0A00, SCN_CNT_INITIALIZED_DATA | SCN_MEM_READ},
+    // .data, without a virtual size
+    {0x3000, 0x0000, 0x0400, SCN_CNT_INITIALIZED_DATA | SCN_MEM_READ | SCN_MEM_WRITE},
+    // .bss, which has no initialized data, so isn't included in either
+    {0x3400, 0x0400, 0x0000, SCN_CNT_UNINITIALIZED_DATA | SCN_MEM_READ | SCN_MEM_WRITE},
+    // A data section running off the end of the image
+    {0x4800, 0x1000, 0x1000, SCN_CNT_INITIALIZED_DATA | SCN_MEM_READ},
+    // A code section starting after the end of the image
+    {0x6000, 0x1000, 0x1000, SCN_CNT_CODE | SCN_MEM_EXECUTE | SCN_MEM_READ},
+};
+
+void test_typical_image(void) {
+    auto image = build_image(typical_sections);
+    bool fell_back = true;
+
+    // Adjacent code sections get merged, and the one past the end gets dropped
+    CHECK(relative_ranges(image, Section::CODE, fell_back) == (Ranges{{0x1000, 0x0F00}}));
+    CHECK(!fell_back);
+
+    // .rdata and .data aren't adjacent, the last data section gets truncated
+    CHECK(relative_ranges(image, Section::DATA, fell_back)
+          == (Ranges{{0x2000, 0x0900}, {0x3000, 0x0400}, {0x4800, 0x0800}}));
+    CHECK(!fell_back);
+
+    CHECK(relative_ranges(image, Section::ANY, fell_back) == (Ranges{{0, IMAGE_SIZE}}));
+    CHECK(!fell_back);
+}
+
+void test_no_matching_sections(void) {
+    auto image = build_image({
+        {0x1000, 0x1000, 0x1000, SCN_CNT_INITIALIZED_DATA | SCN_MEM_READ},
+    });
+    bool fell_back = true;
+
+    // Valid headers without any matching sections shouldn't fall back to the whole image
+    CHECK(relative_ranges(image, Section::CODE, fell_back).empty());
+    CHECK(!fell_back);
+
+    auto no_sections = build_image({});
+    CHECK(relative_ranges(no_sections, Section::DATA, fell_back).empty());
+    CHECK(!fell_back);
+}
+
+void test_invalid_headers(void) {
+    const Ranges whole_image{{0, IMAGE_SIZE}};
+    bool fell_back = false;
+
+    auto check_falls_back = [&](const std::vector<uint8_t>& image) {
+        bool code_fell_back = false;
+        bool data_fell_back = false;
+        const Ranges whole{{0, image.size()}};
+        return CHECK(relative_ranges(image, Section::CODE, code_fell_back) == whole)
+               && CHECK(code_fell_back)
+               && CHECK(relative_ranges(image, Section::DATA, data_fell_back) == whole)
+               && CHECK(data_fell_back);
+    };
+
+    // Too small to even hold a DOS header
+    check_falls_back(std::vector<uint8_t>(0x20, 0));
+
+    auto bad_dos_signature = build_image(typical_sections);
+    write<uint16_t>(bad_dos_signature, 0x00, 0x1234);
+    check_falls_back(bad_dos_signature);
+
+    auto negative_lfanew = build_image(typical_sections);
+    write<int32_t>(negative_lfanew, 0x3C, -1);
+    check_falls_back(negative_lfanew);
+
+    auto lfanew_past_end = build_image(typical_sections);
+    write<int32_t>(lfanew_past_end, 0x3C, IMAGE_SIZE - 4);
+    check_falls_back(lfanew_past_end);
+
+    auto huge_lfanew = build_image(typical_sections);
+    write<int32_t>(huge_lfanew, 0x3C, 0x7FFFFFFF);
+    check_falls_back(huge_lfanew);
+
+    auto bad_nt_signature = build_image(typical_sections);
+    write<uint32_t>(bad_nt_signature, NT_OFFSET, 0x12345678);
+    check_falls_back(bad_nt_signature);
+
+    // Section table running off the end of the image
+    auto too_many_sections = build_image(typical_sections);
+    write<uint16_t>(too_many_sections, NT_OFFSET + 0x06, 0xFFFF);
+    check_falls_back(too_many_sections);
+
+    // Optional header pushing the section table past the end of the image
+    auto small_image = build_image({}, 0x100);
+    write<uint16_t>(small_image, NT_OFFSET + 0x14, 0xFFFF);
+    check_falls_back(small_image);
+
+    // Even on invalid headers, the entire image is a valid result for ANY
+    CHECK(relative_ranges(bad_dos_signature, Section::ANY, fell_back) == whole_image);
+    CHECK(!fell_back);
+}
+
+}  // namespace
+
+int main(void) {
+    test_typical_image();
+    test_no_matching_sections();
+    test_invalid_headers();
+
+    return unrealsdk::tests::result();
+}
@@ -0,0 +1,318 @@
+#include "unrealsdk/pattern_search.h"
+#include "unrealsdk/sigscan_cache.h"
+#include "test_utils.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace unrealsdk::memory;
+using namespace unrealsdk::memory::impl;
+
+namespace {
+
+const constexpr uint64_t EXE_HASH = 0x0123456789ABCDEF;
+
+const constexpr std::array<uint8_t, 4> PATTERN_A_BYTES = {0xDE, 0xAD, 0xBE, 0xEF};
+const constexpr std::array<uint8_t, 4> PATTERN_A_MASK = {0xFF, 0xFF, 0xFF, 0xFF};
+const constexpr std::array<uint8_t, 3> PATTERN_B_BYTES = {0x12, 0x00, 0x56};
+const constexpr std::array<uint8_t, 3> PATTERN_B_MASK = {0xFF, 0x00, 0xFF};
+const constexpr std::array<uint8_t, 2> PATTERN_C_BYTES = {0xCA, 0xFE};
+const constexpr std::array<uint8_t, 2> PATTERN_C_MASK = {0xFF, 0xFF};
+
+const std::vector<PatternView> patterns = {
+    {.bytes = PATTERN_A_BYTES.data(), .mask = PATTERN_A_MASK.data(), .size = 4},
+    {.bytes = PATTERN_B_BYTES.data(), .mask = PATTERN_B_MASK.data(), .size = 3},
+    {.bytes = PATTERN_C_BYTES.data(), .mask = PATTERN_C_MASK.data(), .size = 2},
+};
+
+/**
+ * @brief Builds a fake exe image, containing pattern A at 0x10, and pattern B at 0x40.
+ * @note Pattern C isn't in the image at all.
+ *
+ * @return The image.
+ */
+std::vector<uint8_t> make_image(void) {
+    std::vector<uint8_t> image(0x80, 0);
+    std::ranges::copy(PATTERN_A_BYTES, image.begin() + 0x10);
+    image[0x40] = 0x12;
+    image[0x41] = 0x34;
+    image[0x42] = 0x56;
+    return image;
+}
+
+/**
+ * @brief Hashes all the test patterns.
+ *
+ * @return A list of each pattern's hash, in order.
+ */
+std::vector<uint64_t> hash_patterns(void) {
+    std::vector<uint64_t> hashes{};
+    for (const auto& pattern : patterns) {
+        hashes.push_back(hash_pattern(pattern));
+    }
+    return hashes;
+}
+
+/**
+ * @brief Reads a cache from a string.
+ *
+ * @param str The string to read.
+ * @param cache Output cache.
+ * @param exe_hash The exe hash to expect.
+ * @return The load status.
+ */
+SigscanCacheStatus read_from_string(const std::string& str,
+                                    SigscanCache& cache,
+                                    uint64_t exe_hash = EXE_HASH) {
+    std::istringstream stream{str};
+    return read_sigscan_cache(stream, exe_hash, cache);
+}
+
+void test_hashes(void) {
+    auto hashes = hash_patterns();
+    CHECK(hashes[0] != hashes[1]);
+    CHECK(hashes[0] != hashes[2]);
+    CHECK(hashes[1] != hashes[2]);
+
+    // Any field changing should change the hash
+    auto with_section = patterns[0];
+    with_section.section = Section::CODE;
+    CHECK(hash_pattern(with_section) != hashes[0]);
+
+    const std::array<uint8_t, 4> other_mask = {0xFF, 0xFF, 0xFF, 0xF0};
+    auto with_mask = patterns[0];
+    with_mask.mask = other_mask.data();
+    CHECK(hash_pattern(with_mask) != hashes[0]);
+
+    auto shorter = patterns[0];
+    shorter.size = 3;
+    CHECK(hash_pattern(shorter) != hashes[0]);
+
+    // But it should only depend on the contents, not where the pattern's stored
+    const auto copied_bytes = PATTERN_A_BYTES;
+    auto copied = patterns[0];
+    copied.bytes = copied_bytes.data();
+    CHECK(hash_pattern(copied) == hashes[0]);
+}
+
+void test_round_trip(void) {
+    const SigscanCache written = {
+        {0x1, 0x10}, {0xFFFFFFFFFFFFFFFF, 0x0}, {0xABCDEF, 0x123456}, {0x2, NOT_FOUND}};
+
+    std::stringstream stream{};
+    write_sigscan_cache(stream, EXE_HASH, written);
+
+    SigscanCache loaded{};
+    CHECK(read_sigscan_cache(stream, EXE_HASH, loaded) == SigscanCacheStatus::LOADED);
+    CHECK(loaded == written);
+
+    // An empty cache is still valid
+    std::stringstream empty_stream{};
+    write_sigscan_cache(empty_stream, EXE_HASH, {});
+    SigscanCache empty{{0x1, 0x1}};
+    CHECK(read_sigscan_cache(empty_stream, EXE_HASH, empty) == SigscanCacheStatus::LOADED);
+    CHECK(empty.empty());
+}
+
+void test_invalid_files(void) {
+    const SigscanCache sentinel = {{0x1, 0x2}};
+    auto cache = sentinel;
+
+    CHECK(read_from_string("", cache) == SigscanCacheStatus::UNKNOWN_FORMAT);
+    CHECK(read_from_string("unrealsdk sigscan cache v0\nexe 0\n", cache)
+          == SigscanCacheStatus::UNKNOWN_FORMAT);
+    CHECK(read_from_string("unrealsdk sigscan cache v3\nexe 0\n", cache)
+          == SigscanCacheStatus::UNKNOWN_FORMAT);
+    CHECK(read_from_string("unrealsdk sigscan cache v2\n", cache) == SigscanCacheStatus::INVALID);
+    CHECK(read_from_string("unrealsdk sigscan cache v2\nnotexe 0\n", cache)
+          == SigscanCacheStatus::INVALID);
+    CHECK(read_from_string("unrealsdk sigscan cache v2\nexe 123456789abcdef\n1 zz\n", cache)
+          == SigscanCacheStatus::INVALID);
+    CHECK(read_from_string("unrealsdk sigscan cache v2\nexe 123456789abcdef\nxyz 10\n", cache)
+          == SigscanCacheStatus::INVALID);
+    CHECK(read_from_string("unrealsdk sigscan cache v2\nexe 123456789abcdef\n1 10\n", cache,
+                           EXE_HASH + 1)
+          == SigscanCacheStatus::EXE_CHANGED);
+
+    // None of these should've touched the output
+    CHECK(cache == sentinel);
+}
+
+void test_misses(void) {
+    SigscanCache cache{};
+    CHECK(read_from_string("unrealsdk sigscan cache v2\nexe 123456789abcdef\n1 none\n2 20\n", cache)
+          == SigscanCacheStatus::LOADED);
+    CHECK(cache.size() == 2);
+    CHECK(cache.at(1) == NOT_FOUND);
+    CHECK(cache.at(2) == 0x20);
+
+    // Legacy caches may have recorded misses before the exe was unpacked, so they're ignored
+    SigscanCache legacy{};
+    CHECK(read_from_string("unrealsdk sigscan cache v1\nexe 123456789abcdef\n1 none\n2 20\n",
+                           legacy)
+          == SigscanCacheStatus::LOADED);
+    CHECK(legacy.size() == 1);
+    CHECK(!legacy.contains(1));
+    CHECK(legacy.at(2) == 0x20);
+}
+
+void test_resolve(void) {
+    auto image = make_image();
+    auto start = reinterpret_cast<uintptr_t>(image.data());
+    auto hashes = hash_patterns();
+
+    // A fully valid cache resolves everything it contains, leaving only the missing pattern
+    {
+        const SigscanCache cache = {{hashes[0], 0x10}, {hashes[1], 0x40}};
+        std::vector<uintptr_t> found(patterns.size(), 0);
+        auto to_scan =
+            resolve_from_sigscan_cache(patterns, hashes, cache, start, image.size(), found);
+
+        CHECK(to_scan == std::vector<size_t>{2});
+        CHECK(found[0] == start + 0x10);
+        CHECK(found[1] == start + 0x40);
+        CHECK(found[2] == 0);
+    }
+
+    // Cached misses are trusted, without scanning
+    {
+        const SigscanCache cache = {{hashes[0], 0x10}, {hashes[1], 0x40}, {hashes[2], NOT_FOUND}};
+        std::vector<uintptr_t> found(patterns.size(), 0);
+        auto to_scan =
+            resolve_from_sigscan_cache(patterns, hashes, cache, start, image.size(), found);
+
+        CHECK(to_scan.empty());
+        CHECK(found[0] == start + 0x10);
+        CHECK(found[1] == start + 0x40);
+        CHECK(found[2] == 0);
+    }
+
+    // Stale offsets, including ones past the end of the image, get rescanned
+    {
+        const SigscanCache cache = {
+            {hashes[0], 0x11},
+            {hashes[1], image.size() - 2},
+            {hashes[2], std::numeric_limits<size_t>::max() - 1},
+        };
+        std::vector<uintptr_t> found(patterns.size(), 0);
+        auto to_scan =
+            resolve_from_sigscan_cache(patterns, hashes, cache, start, image.size(), found);
+
+        CHECK(to_scan == (std::vector<size_t>{0, 1, 2}));
+        CHECK(found == std::vector<uintptr_t>(patterns.size(), 0));
+    }
+}
+
+void test_build(void) {
+    const uintptr_t start = 0x400000;
+    const std::vector<uint64_t> hashes = {0x1, 0x2, 0x3};
+    const std::vector<uintptr_t> found = {start + 0x10, 0, 0};
+    // Pattern 2 was previously known to be missing, pattern 3 is newly missing
+    const SigscanCache old_cache = {{0x1, 0x20}, {0x2, NOT_FOUND}};
+
+    CHECK(build_sigscan_cache(hashes, found, old_cache, start, true)
+          == (SigscanCache{{0x1, 0x10}, {0x2, NOT_FOUND}, {0x3, NOT_FOUND}}));
+    // If we can't trust misses, we shouldn't add any new ones, but can keep the existing ones
+    CHECK(build_sigscan_cache(hashes, found, old_cache, start, false)
+          == (SigscanCache{{0x1, 0x10}, {0x2, NOT_FOUND}}));
+}
+
+void test_load_validate_scan(void) {
+    // Simulates a full prescan: load the cache, validate it, scan for the rest, then save
+    auto image = make_image();
+    auto start = reinterpret_cast<uintptr_t>(image.data());
+    auto hashes = hash_patterns();
+
+    auto prescan = [&](const std::string& cache_file, bool cache_misses, SigscanCache& new_cache) {
+        SigscanCache cache{};
+        (void)read_from_string(cache_file, cache);
+
+        std::vector<uintptr_t> found(patterns.size(), 0);
+        auto to_scan =
+            resolve_from_sigscan_cache(patterns, hashes, cache, start, image.size(), found);
+
+        for (auto idx : to_scan) {
+            const PreparedPattern prepared{patterns[idx].bytes, patterns[idx].mask,
+                                           patterns[idx].size};
+            auto offset = find_pattern(image.data(), image.size() - prepared.size, prepared,
+                                       SimdLevel::SCALAR);
+            if (offset != NOT_FOUND) {
+                found[idx] = start + offset;
+            }
+        }
+
+        new_cache = build_sigscan_cache(hashes, found, cache, start, cache_misses);
+        return std::make_pair(found, to_scan.size());
+    };
+
+    // Cold start, while the exe might still be packed, everything gets scanned, and only the hits
+    // get cached
+    SigscanCache cold_cache{};
+    auto [cold_found, cold_scanned] = prescan("", false, cold_cache);
+    CHECK(cold_scanned == 3);
+    CHECK(cold_found[0] == start + 0x10);
+    CHECK(cold_found[1] == start + 0x40);
+    CHECK(cold_found[2] == 0);
+    CHECK(cold_cache.size() == 2);
+
+    std::stringstream cold_file{};
+    write_sigscan_cache(cold_file, EXE_HASH, cold_cache);
+
+    // Warm start, only the miss gets rescanned
+    SigscanCache warm_cache{};
+    auto [warm_found, warm_scanned] = prescan(cold_file.str(), false, warm_cache);
+    CHECK(warm_scanned == 1);
+    CHECK(warm_found == cold_found);
+    CHECK(warm_cache == cold_cache);
+
+    // Once we know the exe's unpacked, the miss gets cached too
+    SigscanCache trusted_cache{};
+    auto [trusted_found, trusted_scanned] = prescan(cold_file.str(), true, trusted_cache);
+    CHECK(trusted_scanned == 1);
+    CHECK(trusted_found == cold_found);
+    CHECK(trusted_cache.size() == 3);
+    CHECK(trusted_cache.at(hashes[2]) == NOT_FOUND);
+
+    std::stringstream trusted_file{};
+    write_sigscan_cache(trusted_file, EXE_HASH, trusted_cache);
+
+    // So the next warm start doesn't need to scan at all - even if it can't tell if it's unpacked
+    SigscanCache fully_warm_cache{};
+    auto [fully_warm_found, fully_warm_scanned] =
+        prescan(trusted_file.str(), false, fully_warm_cache);
+    CHECK(fully_warm_scanned == 0);
+    CHECK(fully_warm_found == cold_found);
+    CHECK(fully_warm_cache == trusted_cache);
+
+    // Move pattern A, so the cached offset goes stale, and add pattern C, which was previously
+    // missed - both should be found by falling back to scanning
+    std::ranges::fill(image.begin() + 0x10, image.begin() + 0x14, 0);
+    std::ranges::copy(PATTERN_A_BYTES, image.begin() + 0x20);
+    std::ranges::copy(PATTERN_C_BYTES, image.begin() + 0x60);
+
+    SigscanCache updated_cache{};
+    auto [updated_found, updated_scanned] = prescan(cold_file.str(), true, updated_cache);
+    CHECK(updated_scanned == 2);
+    CHECK(updated_found[0] == start + 0x20);
+    CHECK(updated_found[1] == start + 0x40);
+    CHECK(updated_found[2] == start + 0x60);
+    CHECK(updated_cache.size() == 3);
+}
+
+}  // namespace
+
+int main(void) {
+    test_hashes();
+    test_round_trip();
+    test_invalid_files();
+    test_misses();
+    test_build();
+    test_resolve();
+    test_load_validate_scan();
+
+    return unrealsdk::tests::result();
+}
@@ -0,0 +1,53 @@
+#ifndef TESTS_TEST_UTILS_H
+#define TESTS_TEST_UTILS_H
+
+#include <cstdio>
+
+namespace unrealsdk::tests {
+
+/*
+A deliberately tiny test harness, so the tests don't need any extra dependencies.
+
+Each test is its own executable, which uses `CHECK` for each assertion, and returns
+`tests::result()` from main. Failed checks are printed, but don't stop the test, so a single run
+reports every failure.
+*/
+
+inline int failures = 0;
+
+/**
+ * @brief Records the result of a check.
+ *
+ * @param passed True if the check passed.
+ * @param expr The checked expression, for printing.
+ * @param file The file the check is in.
+ * @param line The line the check is on.
+ * @return The value of passed.
+ */
+inline bool check(bool passed, const char* expr, const char* file, int line) {
+    if (!passed) {
+        failures++;
+        (void)fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+    return passed;
+}
+
+/**
+ * @brief Gets the process exit code representing the result of all checks.
+ *
+ * @return The exit code.
+ */
+inline int result(void) {
+    if (failures != 0) {
+        (void)fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
+
+}  // namespace unrealsdk::tests
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define CHECK(expr) unrealsdk::tests::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif /* TESTS_TEST_UTILS_H */
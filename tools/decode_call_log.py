@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""
+Decodes a binary call log, as written by `unrealsdk::hook_manager::log_all_calls` when
+`unrealsdk.log_all_calls_format` is set to "binary", into TSV.
+
+Each output line contains the thread id, the call's timestamp (in nanoseconds since logging
+started), the source, the function's path name, and the object's path name. See
+`src/unrealsdk/call_log_format.h` for a description of the format.
+"""
+
+import argparse
+import struct
+import sys
+from collections.abc import Iterator
+from dataclasses import dataclass
+from typing import BinaryIO, TextIO
+
+MAGIC = b"USDKCALL"
+VERSION = 1
+BLOCK_TYPE_CALLS = 1
+
+TAG_CALL = 0
+TAG_NAME = 1
+
+FILE_HEADER = struct.Struct("<8sI")
+BLOCK_HEADER = struct.Struct("<BIQI")
+
+MAX_VARINT_SHIFT = 63
+
+
+class CallLogError(Exception):
+    pass
+
+
+@dataclass
+class Call:
+    thread_id: int
+    time_ns: int
+    source: str
+    func: str
+    obj: str
+
+
+def read_varint(data: bytes, pos: int) -> tuple[int, int]:
+    """
+    Reads a LEB128 varint.
+
+    Args:
+        data: The data to read from.
+        pos: The position to start reading at.
+    Returns:
+        A tuple of the value, and the position after it.
+    """
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise CallLogError("Truncated varint")
+        byte = data[pos]
+        pos += 1
+
+        value |= (byte & 0x7F) << shift
+        if (byte & 0x80) == 0:
+            return value, pos
+
+        shift += 7
+        if shift > MAX_VARINT_SHIFT:
+            raise CallLogError("Varint too long")
+
+
+def read_zigzag(data: bytes, pos: int) -> tuple[int, int]:
+    """
+    Reads a zigzag encoded LEB128 varint.
+
+    Args:
+        data: The data to read from.
+        pos: The position to start reading at.
+    Returns:
+        A tuple of the value, and the position after it.
+    """
+    raw, pos = read_varint(data, pos)
+    return (raw >> 1) ^ -(raw & 1), pos
+
+
+def decode_block(
+    thread_id: int,
+    base_time: int,
+    payload: bytes,
+    names: dict[int, str],
+) -> Iterator[Call]:
+    """
+    Decodes a single block of calls.
+
+    Args:
+        thread_id: The thread id from the block header.
+        base_time: The base timestamp from the block header.
+        payload: The block's payload.
+        names: The names seen on this thread so far. Updated with any new names.
+    Returns:
+        An iterator of the calls in the block.
+    """
+
+    def name_of(ptr: int) -> str:
+        return names.get(ptr, f"<unknown 0x{ptr:x}>")
+
+    time = base_time
+    source = func = obj = 0
+
+    pos = 0
+    while pos < len(payload):
+        tag, pos = read_varint(payload, pos)
+
+        if tag == TAG_CALL:
+            delta, pos = read_varint(payload, pos)
+            time += delta
+
+            delta, pos = read_zigzag(payload, pos)
+            source += delta
+            delta, pos = read_zigzag(payload, pos)
+            func += delta
+            delta, pos = read_zigzag(payload, pos)
+            obj += delta
+
+            yield Call(thread_id, time, name_of(source), name_of(func), name_of(obj))
+
+        elif tag == TAG_NAME:
+            ptr, pos = read_varint(payload, pos)
+            length, pos = read_varint(payload, pos)
+
+            end = pos + length * 2
+            if end > len(payload):
+                raise CallLogError("Truncated name")
+            names[ptr] = payload[pos:end].decode("utf-16-le", errors="replace")
+            pos = end
+
+        else:
+            raise CallLogError(f"Unknown entry tag {tag}")
+
+
+def decode(stream: BinaryIO) -> Iterator[Call]:
+    """
+    Decodes a binary call log.
+
+    Args:
+        stream: The stream to read the log from.
+    Returns:
+        An iterator of all calls in the log, in the order their blocks were written.
+    """
+    header = stream.read(FILE_HEADER.size)
+    if len(header) < FILE_HEADER.size:
+        raise CallLogError("Not a binary call log")
+    magic, version = FILE_HEADER.unpack(header)
+    if magic != MAGIC:
+        raise CallLogError("Not a binary call log")
+    if version != VERSION:
+        raise CallLogError(f"Unsupported format version {version}")
+
+    names: dict[int, dict[int, str]] = {}
+    while block_header := stream.read(BLOCK_HEADER.size):
+        if len(block_header) < BLOCK_HEADER.size:
+            raise CallLogError("Truncated block header")
+        block_type, thread_id, base_time, size = BLOCK_HEADER.unpack(block_header)
+
+        payload = stream.read(size)
+        if len(payload) < size:
+            raise CallLogError("Truncated block")
+
+        # Blocks are sized, so we can safely skip over any types from future versions
+        if block_type != BLOCK_TYPE_CALLS:
+            continue
+
+        yield from decode_block(thread_id, base_time, payload, names.setdefault(thread_id, {}))
+
+
+def write_tsv(calls: Iterator[Call], output: TextIO) -> None:
+    """
+    Writes calls as TSV.
+
+    Args:
+        calls: The calls to write.
+        output: The stream to write to.
+    """
+    for call in calls:
+        output.write(f"{call.thread_id}\t{call.time_ns}\t{call.source}\t{call.func}\t{call.obj}\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Decodes a binary call log into TSV.")
+    parser.add_argument("log", help="The binary call log to decode.")
+    parser.add_argument(
+        "-o",
+        "--output",
+        help="The file to write to. Defaults to stdout.",
+    )
+    args = parser.parse_args()
+
+    with open(args.log, "rb") as log:
+        calls = decode(log)
+        try:
+            if args.output is None:
+                write_tsv(calls, sys.stdout)
+            else:
+                with open(args.output, "w", encoding="utf-8", newline="\n") as output:
+                    write_tsv(calls, output)
+        except CallLogError as ex:
+            print(f"Failed to decode call log: {ex}", file=sys.stderr)
+            sys.exit(1)